@@ -0,0 +1,10 @@
+/**
+ * @file ldmx-bench.cxx
+ * @brief Run the microbenchmark suite
+ */
+
+#include "Benchmarks/Benchmark.h"
+
+int main(int argc, char* argv[]) {
+    return ldmx::bench::runAll(argc, argv);
+}
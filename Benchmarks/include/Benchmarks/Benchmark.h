@@ -0,0 +1,189 @@
+/**
+ * @file Benchmark.h
+ * @brief Small in-tree microbenchmark harness
+ */
+
+#ifndef BENCHMARKS_BENCHMARK_H
+#define BENCHMARKS_BENCHMARK_H
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ldmx {
+namespace bench {
+
+    /**
+     * @class State
+     * @brief Iteration control and timing of one benchmark run
+     *
+     * A benchmark prepares its fixture and then loops over the code under
+     * test with
+     *
+     *     while (state.keepRunning()) { ... }
+     *
+     * The clock starts at the first call of keepRunning, so the fixture
+     * isn't timed, and stops once the requested number of iterations is done.
+     */
+    class State {
+
+        public:
+
+            /**
+             * Constructor
+             *
+             * @param[in] iterations number of times the loop runs
+             * @param[in] arg argument of the benchmark, 0 if it has none
+             */
+            State(long iterations, long arg) : iterations_{iterations}, arg_{arg} { }
+
+            /// @return true while there are iterations left
+            bool keepRunning() {
+                if (done_ == 0 and not started_) {
+                    started_ = true;
+                    startWall_ = Clock::now();
+                    startCPU_ = std::clock();
+                }
+                if (done_ < iterations_) { ++done_; return true; }
+                stop();
+                return false;
+            }
+
+            /// @return the number of iterations of the run
+            long iterations() const { return iterations_; }
+
+            /// @return the argument of the benchmark
+            long arg() const { return arg_; }
+
+            /**
+             * Set the number of items processed by each iteration.
+             *
+             * Items per second are then added to the results.
+             */
+            void setItemsPerIteration(long items) { itemsPerIteration_ = items; }
+
+            /**
+             * Skip the benchmark, e.g. if an input it needs isn't available.
+             *
+             * @param[in] reason printed in place of the results
+             */
+            void skip(const std::string& reason) { skipped_ = reason; }
+
+            /// @return the reason the benchmark was skipped, empty if it wasn't
+            const std::string& skipped() const { return skipped_; }
+
+            /// @return the wall time of the loop [s]
+            double realTime() const { return realTime_; }
+
+            /// @return the CPU time of the loop [s]
+            double cpuTime() const { return cpuTime_; }
+
+            /// @return the number of items processed by each iteration, 0 if not set
+            long itemsPerIteration() const { return itemsPerIteration_; }
+
+        private:
+
+            typedef std::chrono::steady_clock Clock;
+
+            /// Stop the clock
+            void stop() {
+                if (stopped_) return;
+                stopped_ = true;
+                realTime_ = std::chrono::duration<double>(Clock::now() - startWall_).count();
+                cpuTime_ = double(std::clock() - startCPU_)/CLOCKS_PER_SEC;
+            }
+
+            long iterations_;
+            long arg_;
+            long done_{0};
+            bool started_{false}, stopped_{false};
+            Clock::time_point startWall_;
+            std::clock_t startCPU_{0};
+            double realTime_{0}, cpuTime_{0};
+            long itemsPerIteration_{0};
+            std::string skipped_;
+    };
+
+    /// Signature of a benchmark
+    typedef std::function<void(State&)> Function;
+
+    /**
+     * Add a benchmark to the suite.
+     *
+     * @param[in] name name of the benchmark
+     * @param[in] function the benchmark
+     * @param[in] args arguments to run the benchmark with, one run per argument
+     */
+    void add(const std::string& name, Function function, const std::vector<long>& args = {});
+
+    /**
+     * Run the registered benchmarks.
+     *
+     * Options:
+     *  --filter=<regex>     only run the benchmarks whose name matches
+     *  --min-time=<s>       minimum time of each measurement, default 0.5
+     *  --repetitions=<n>    number of measurements of each benchmark, default 3
+     *  --json=<file>        also write the results as JSON to the file
+     *  --list               only list the benchmarks
+     *
+     * The JSON follows the layout of the Google Benchmark output, so the
+     * results can be compared across releases with the same tools.
+     *
+     * @return the exit code of the program
+     */
+    int runAll(int argc, char* argv[]);
+
+    /**
+     * Keep the compiler from optimizing away a value.
+     *
+     * @param[in] value result of the code under test
+     */
+    template <class T>
+    inline void doNotOptimize(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    /// Keep the compiler from optimizing away writes to memory
+    inline void clobberMemory() {
+        asm volatile("" : : : "memory");
+    }
+
+    /**
+     * @class Registrar
+     * @brief Adds a benchmark to the suite at static initialization
+     */
+    struct Registrar {
+        Registrar(const std::string& name, Function function, const std::vector<long>& args = {}) {
+            add(name, function, args);
+        }
+    };
+
+} // bench
+} // ldmx
+
+/**
+ * Define a benchmark
+ *
+ *     LDMX_BENCHMARK(Name) { ... while (state.keepRunning()) { ... } }
+ */
+#define LDMX_BENCHMARK(NAME) \
+    static void NAME(ldmx::bench::State&); \
+    static ldmx::bench::Registrar NAME##_registrar(#NAME, NAME); \
+    static void NAME(ldmx::bench::State& state)
+
+/**
+ * Define a benchmark run once per argument, read with state.arg()
+ *
+ *     LDMX_BENCHMARK_ARGS(Name, 10, 100, 1000) { ... }
+ */
+#define LDMX_BENCHMARK_ARGS(NAME, ...) \
+    static void NAME(ldmx::bench::State&); \
+    static ldmx::bench::Registrar NAME##_registrar(#NAME, NAME, {__VA_ARGS__}); \
+    static void NAME(ldmx::bench::State& state)
+
+#endif // BENCHMARKS_BENCHMARK_H
@@ -0,0 +1,201 @@
+
+#include "Benchmarks/Benchmark.h"
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <thread>
+
+#include <unistd.h>
+
+namespace ldmx {
+namespace bench {
+
+    namespace {
+
+        /// A registered benchmark with one of its arguments
+        struct Entry {
+            std::string name;
+            Function function;
+            long arg;
+        };
+
+        /// One measurement
+        struct Result {
+            std::string name;
+            int repetition;
+            long iterations;
+            double realTime, cpuTime; // ns per iteration
+            double itemsPerSecond;
+        };
+
+        std::vector<Entry>& registry() {
+            static std::vector<Entry> entries;
+            return entries;
+        }
+
+        std::string escape(const std::string& s) {
+            std::string out;
+            for (char c : s) {
+                if (c == '"' or c == '\\') out += '\\';
+                out += c;
+            }
+            return out;
+        }
+
+        /**
+         * Find the number of iterations that takes at least minTime, growing
+         * it like Google Benchmark does.
+         *
+         * @return the number of iterations, 0 if the benchmark skipped itself
+         */
+        long calibrate(const Entry& entry, double minTime, std::string& skipped) {
+            long iterations{1};
+            while (true) {
+                State state(iterations, entry.arg);
+                entry.function(state);
+                if (not state.skipped().empty()) {
+                    skipped = state.skipped();
+                    return 0;
+                }
+                double time{state.realTime()};
+                if (time >= minTime or iterations >= 1000000000L) return iterations;
+                double multiplier{time > 0 ? 1.4*minTime/time : 10.};
+                multiplier = std::min(10., std::max(2., multiplier));
+                iterations = long(iterations*multiplier);
+            }
+        }
+
+        void writeJSON(const std::string& path, const std::string& executable,
+                int repetitions, const std::vector<Result>& results) {
+            std::ofstream out(path);
+            if (not out) {
+                std::cerr << "[ ldmx-bench ]: Unable to open '" << path << "'." << std::endl;
+                return;
+            }
+
+            char host[256]{0};
+            gethostname(host, sizeof(host) - 1);
+            std::time_t now{std::time(nullptr)};
+            char date[64];
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+            out << std::setprecision(10);
+            out << "{\n  \"context\": {\n"
+                << "    \"date\": \"" << date << "\",\n"
+                << "    \"host_name\": \"" << escape(host) << "\",\n"
+                << "    \"executable\": \"" << escape(executable) << "\",\n"
+                << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+#ifdef NDEBUG
+                << "    \"library_build_type\": \"release\"\n"
+#else
+                << "    \"library_build_type\": \"debug\"\n"
+#endif
+                << "  },\n  \"benchmarks\": [";
+            for (std::size_t i{0}; i < results.size(); ++i) {
+                const Result& r{results[i]};
+                out << (i == 0 ? "\n" : ",\n")
+                    << "    {\n"
+                    << "      \"name\": \"" << escape(r.name) << "\",\n"
+                    << "      \"run_name\": \"" << escape(r.name) << "\",\n"
+                    << "      \"run_type\": \"iteration\",\n"
+                    << "      \"repetitions\": " << repetitions << ",\n"
+                    << "      \"repetition_index\": " << r.repetition << ",\n"
+                    << "      \"iterations\": " << r.iterations << ",\n"
+                    << "      \"real_time\": " << r.realTime << ",\n"
+                    << "      \"cpu_time\": " << r.cpuTime << ",\n"
+                    << "      \"time_unit\": \"ns\"";
+                if (r.itemsPerSecond > 0) out << ",\n      \"items_per_second\": " << r.itemsPerSecond;
+                out << "\n    }";
+            }
+            out << "\n  ]\n}\n";
+        }
+
+    } // anonymous
+
+    void add(const std::string& name, Function function, const std::vector<long>& args) {
+        if (args.empty()) {
+            registry().push_back({name, function, 0});
+        } else {
+            for (long arg : args) registry().push_back({name + "/" + std::to_string(arg), function, arg});
+        }
+    }
+
+    int runAll(int argc, char* argv[]) {
+
+        std::string filter{".*"}, json;
+        double minTime{0.5};
+        int repetitions{3};
+        bool list{false};
+        for (int i{1}; i < argc; ++i) {
+            std::string opt{argv[i]};
+            auto value = [&opt] () { return opt.substr(opt.find('=') + 1); };
+            if (opt.rfind("--filter=", 0) == 0) filter = value();
+            else if (opt.rfind("--min-time=", 0) == 0) minTime = std::stod(value());
+            else if (opt.rfind("--repetitions=", 0) == 0) repetitions = std::max(1, std::stoi(value()));
+            else if (opt.rfind("--json=", 0) == 0) json = value();
+            else if (opt == "--list") list = true;
+            else {
+                std::cerr << "Usage: " << argv[0] << " [--filter=<regex>] [--min-time=<s>]"
+                    << " [--repetitions=<n>] [--json=<file>] [--list]" << std::endl;
+                return 1;
+            }
+        }
+
+        std::regex pattern(filter);
+        std::vector<const Entry*> selected;
+        for (const Entry& entry : registry()) {
+            if (std::regex_search(entry.name, pattern)) selected.push_back(&entry);
+        }
+
+        if (list) {
+            for (const Entry* entry : selected) std::cout << entry->name << std::endl;
+            return 0;
+        }
+
+        std::vector<Result> results;
+        std::size_t width{9};
+        for (const Entry* entry : selected) width = std::max(width, entry->name.size());
+        std::cout << std::left << std::setw(width) << "Benchmark" << std::right
+            << std::setw(15) << "Time [ns]" << std::setw(15) << "CPU [ns]"
+            << std::setw(13) << "Iterations" << std::setw(15) << "Items/s" << std::endl;
+
+        for (const Entry* entry : selected) {
+            std::string skipped;
+            long iterations{calibrate(*entry, minTime, skipped)};
+            if (iterations == 0) {
+                std::cout << std::left << std::setw(width) << entry->name
+                    << "  skipped: " << skipped << std::endl;
+                continue;
+            }
+
+            for (int rep{0}; rep < repetitions; ++rep) {
+                State state(iterations, entry->arg);
+                entry->function(state);
+                Result r{entry->name, rep, iterations,
+                    1e9*state.realTime()/iterations, 1e9*state.cpuTime()/iterations, 0.};
+                if (state.itemsPerIteration() > 0 and state.realTime() > 0) {
+                    r.itemsPerSecond = double(state.itemsPerIteration())*iterations/state.realTime();
+                }
+                results.push_back(r);
+
+                std::cout << std::left << std::setw(width) << entry->name << std::right << std::fixed
+                    << std::setprecision(1) << std::setw(15) << r.realTime << std::setw(15) << r.cpuTime
+                    << std::setw(13) << iterations << std::setprecision(0) << std::setw(15);
+                if (r.itemsPerSecond > 0) std::cout << r.itemsPerSecond;
+                else std::cout << "";
+                std::cout << std::defaultfloat << std::endl;
+            }
+        }
+
+        if (not json.empty()) writeJSON(json, argv[0], repetitions, results);
+        return 0;
+    }
+
+} // bench
+} // ldmx
@@ -0,0 +1,144 @@
+/**
+ * @file DetDescrBenchmarks.cxx
+ * @brief Benchmarks of the EcalHexReadout lookups and detector ID decoding
+ */
+
+#include "Benchmarks/Benchmark.h"
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <algorithm>
+#include <memory>
+#include <random>
+
+//----------//
+//   ldmx   //
+//----------//
+#include "DetDescr/DetectorIDInterpreter.h"
+#include "DetDescr/EcalHexReadout.h"
+#include "EcalHexReadoutV12.h" // test support from DetDescr/test
+#include "DetDescr/EcalID.h"
+#include "DetDescr/HcalID.h"
+
+namespace ldmx {
+namespace bench {
+
+    namespace {
+
+        /// Number of lookups in each iteration
+        const std::size_t N_LOOKUPS{4096};
+
+        /// EcalHexReadout with the v12 geometry parameters
+        const EcalHexReadout& hexReadout() {
+            static std::unique_ptr<EcalHexReadout> readout{test::makeV12EcalHexReadout()};
+            return *readout;
+        }
+
+        /// Random valid Ecal cell IDs
+        std::vector<EcalID> randomEcalIDs(std::size_t n) {
+            const auto& readout{hexReadout()};
+            std::mt19937 rng(1);
+            std::uniform_int_distribution<int> layer(0, readout.getNumLayers() - 1);
+            std::uniform_int_distribution<int> module(0, readout.getNumModulesPerLayer() - 1);
+            std::uniform_int_distribution<int> cell(0, readout.getNumCellsPerModule() - 1);
+            std::vector<EcalID> ids;
+            ids.reserve(n);
+            for (std::size_t i{0}; i < n; ++i) ids.emplace_back(layer(rng), module(rng), cell(rng));
+            return ids;
+        }
+
+    } // anonymous
+
+    LDMX_BENCHMARK(EcalHexReadout_CellAbsolutePosition) {
+        const auto& readout{hexReadout()};
+        auto ids{randomEcalIDs(N_LOOKUPS)};
+        state.setItemsPerIteration(ids.size());
+        while (state.keepRunning()) {
+            double x, y, z;
+            for (const EcalID& id : ids) {
+                readout.getCellAbsolutePosition(id, x, y, z);
+                doNotOptimize(x);
+                doNotOptimize(y);
+                doNotOptimize(z);
+            }
+        }
+    }
+
+    LDMX_BENCHMARK(EcalHexReadout_CellModuleIDFromXY) {
+        const auto& readout{hexReadout()};
+
+        // Points at the centers of random cells, shifted by up to a third of a cell
+        std::mt19937 rng(2);
+        std::uniform_real_distribution<double> shift(-readout.getCellMinR()/3, readout.getCellMinR()/3);
+        std::vector<std::pair<double,double>> points;
+        for (const EcalID& id : randomEcalIDs(N_LOOKUPS)) {
+            auto [x, y] = readout.getCellCenterAbsolute(EcalID(0, id.module(), id.cell()));
+            points.emplace_back(x + shift(rng), y + shift(rng));
+        }
+
+        state.setItemsPerIteration(points.size());
+        while (state.keepRunning()) {
+            for (const auto& [x, y] : points) doNotOptimize(readout.getCellModuleID(x, y));
+        }
+    }
+
+    LDMX_BENCHMARK(EcalHexReadout_NeighborRanges) {
+        const auto& readout{hexReadout()};
+        auto ids{randomEcalIDs(N_LOOKUPS)};
+        state.setItemsPerIteration(ids.size());
+        while (state.keepRunning()) {
+            for (const EcalID& id : ids) {
+                doNotOptimize(readout.getNNRange(id).size());
+                doNotOptimize(readout.getNNNRange(id).size());
+            }
+        }
+    }
+
+    LDMX_BENCHMARK(EcalHexReadout_IsNN) {
+        const auto& readout{hexReadout()};
+        auto centroids{randomEcalIDs(N_LOOKUPS)};
+        std::vector<EcalID> probes;
+        for (const EcalID& id : centroids) {
+            auto nn{readout.getNN(id)};
+            probes.push_back(nn.empty() ? id : nn.front());
+        }
+        state.setItemsPerIteration(centroids.size());
+        while (state.keepRunning()) {
+            for (std::size_t i{0}; i < centroids.size(); ++i) {
+                doNotOptimize(readout.isNN(centroids[i], probes[i]));
+            }
+        }
+    }
+
+    LDMX_BENCHMARK(DetectorIDInterpreter_Decode) {
+        auto ecalIDs{randomEcalIDs(N_LOOKUPS/2)};
+        std::vector<DetectorID> ids(ecalIDs.begin(), ecalIDs.end());
+        std::mt19937 rng(3);
+        for (std::size_t i{0}; i < N_LOOKUPS/2; ++i) ids.push_back(HcalID(rng() % 3, rng() % 100, rng() % 62));
+        std::shuffle(ids.begin(), ids.end(), rng);
+
+        state.setItemsPerIteration(ids.size());
+        DetectorIDInterpreter interpreter;
+        while (state.keepRunning()) {
+            for (const DetectorID& id : ids) {
+                interpreter.setRawValue(id);
+                for (int i{0}; i < interpreter.getFieldCount(); ++i) doNotOptimize(interpreter.getFieldValue(i));
+            }
+        }
+    }
+
+    LDMX_BENCHMARK(EcalID_Unpack) {
+        auto ecalIDs{randomEcalIDs(N_LOOKUPS)};
+        std::vector<DetectorID::RawValue> raw;
+        for (const EcalID& id : ecalIDs) raw.push_back(id.raw());
+        std::vector<int> layers(raw.size()), modules(raw.size()), cells(raw.size());
+        state.setItemsPerIteration(raw.size());
+        while (state.keepRunning()) {
+            EcalID::unpack(raw.data(), raw.size(), layers.data(), modules.data(), cells.data());
+            clobberMemory();
+        }
+    }
+
+} // bench
+} // ldmx
@@ -0,0 +1,169 @@
+/**
+ * @file HgcrocBenchmarks.cxx
+ * @brief Benchmarks of the HGCROC emulation and digi formats
+ */
+
+#include "Benchmarks/Benchmark.h"
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <any>
+#include <cmath>
+#include <map>
+#include <random>
+
+//----------//
+//   ldmx   //
+//----------//
+#include "Recon/Event/HgcrocDigiCollection.h"
+#include "Recon/Event/HgcrocTrigDigi.h"
+#include "Tools/HgcrocEmulator.h"
+
+namespace ldmx {
+namespace bench {
+
+    namespace {
+
+        /// Voltage of one MIP in a 20 pF readout pad, assuming 37k e-h pairs [mV]
+        const double MIP{37000*(0.162/1000.)/20.};
+
+        /// Emulator parameters, the defaults of Tools/python/HgcrocEmulator.py
+        Parameters emulatorParameters() {
+            std::map<std::string,std::any> params;
+            double clockCycle{25.}, totMax{200.}, capacitance{20.}, gain{320./capacitance/1024}, pedestal{50.};
+            params["pedestal"] = pedestal;
+            params["clockCycle"] = clockCycle;
+            params["measTime"] = 0.;
+            params["timingJitter"] = clockCycle/100.;
+            params["readoutPadCapacitance"] = capacitance;
+            params["nADCs"] = 10;
+            params["iSOI"] = 0;
+            params["totMax"] = totMax;
+            params["drainRate"] = 10240./totMax;
+            params["rateUpSlope"] = -0.345;
+            params["timeUpSlope"] = 70.6547;
+            params["rateDnSlope"] = 0.140068;
+            params["timeDnSlope"] = 87.7649;
+            params["timePeak"] = 77.732;
+            params["gain"] = gain;
+            params["noiseRMS"] = (700. + 25.*capacitance)*(0.162/1000.)/capacitance;
+            params["readoutThreshold"] = pedestal + 2.;
+            params["toaThreshold"] = gain*pedestal + 5*MIP;
+            params["totThreshold"] = gain*pedestal + 50*MIP;
+            params["noise"] = true;
+
+            Parameters ps;
+            ps.setParameters(params);
+            return ps;
+        }
+
+        /// Random 10-sample digis, a tenth of them in TOT mode
+        HgcrocDigiCollection randomDigis(std::size_t n) {
+            std::mt19937 rng(4);
+            std::uniform_int_distribution<int> adc(0, 1023);
+            HgcrocDigiCollection digis;
+            digis.setNumSamplesPerDigi(10);
+            digis.setSampleOfInterestIndex(0);
+            std::vector<HgcrocDigiCollection::Sample> samples(10);
+            for (std::size_t i{0}; i < n; ++i) {
+                bool tot{rng() % 10 == 0};
+                for (std::size_t s{0}; s < samples.size(); ++s) {
+                    samples[s] = HgcrocDigiCollection::Sample(tot and s > 0, tot and s == 0,
+                            adc(rng), tot and s == 0 ? 4*adc(rng) : adc(rng), adc(rng));
+                }
+                digis.addDigi(i, samples);
+            }
+            return digis;
+        }
+
+    } // anonymous
+
+    LDMX_BENCHMARK_ARGS(HgcrocEmulator_Digitize, 1, 10, 100) {
+        HgcrocEmulator emulator(emulatorParameters());
+        emulator.seedGenerator(5);
+
+        // Hits from 0.1 to 500 MIPs, log uniform, with state.arg() percent of
+        // them above the TOT threshold
+        std::mt19937 rng(6);
+        std::uniform_real_distribution<double> logAmplitude(std::log(0.1), std::log(50.));
+        std::uniform_real_distribution<double> logTOTAmplitude(std::log(60.), std::log(500.));
+        std::uniform_real_distribution<double> time(0., 20.);
+        std::uniform_int_distribution<int> percent(0, 99);
+        const std::size_t nHits{1024};
+        std::vector<std::vector<double>> voltages(nHits), times(nHits);
+        for (std::size_t i{0}; i < nHits; ++i) {
+            bool tot{percent(rng) < state.arg()};
+            voltages[i] = {MIP*std::exp(tot ? logTOTAmplitude(rng) : logAmplitude(rng))};
+            times[i] = {time(rng)};
+        }
+
+        std::vector<HgcrocDigiCollection::Sample> digi;
+        state.setItemsPerIteration(nHits);
+        while (state.keepRunning()) {
+            for (std::size_t i{0}; i < nHits; ++i) {
+                doNotOptimize(emulator.digitize(i, voltages[i], times[i], digi));
+            }
+        }
+    }
+
+    LDMX_BENCHMARK(HgcrocDigiCollection_Encode) {
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> adc(0, 1023);
+        const std::size_t nDigis{1024};
+        std::vector<int> values(nDigis*10*3);
+        for (int& v : values) v = adc(rng);
+
+        HgcrocDigiCollection digis;
+        digis.setNumSamplesPerDigi(10);
+        std::vector<HgcrocDigiCollection::Sample> samples(10);
+        state.setItemsPerIteration(nDigis);
+        while (state.keepRunning()) {
+            digis.Clear();
+            const int* v{values.data()};
+            for (std::size_t i{0}; i < nDigis; ++i) {
+                for (auto& sample : samples) {
+                    sample = HgcrocDigiCollection::Sample(false, false, v[0], v[1], v[2]);
+                    v += 3;
+                }
+                digis.addDigi(i, samples);
+            }
+            doNotOptimize(digis.getNumDigis());
+        }
+    }
+
+    LDMX_BENCHMARK(HgcrocDigiCollection_Decode) {
+        auto digis{randomDigis(1024)};
+        state.setItemsPerIteration(digis.getNumDigis());
+        while (state.keepRunning()) {
+            for (unsigned int i{0}; i < digis.getNumDigis(); ++i) {
+                auto digi{digis.getDigi(i)};
+                if (digi.isTOT()) doNotOptimize(digi.tot());
+                else doNotOptimize(digi.soi().adc_t());
+                doNotOptimize(digi.soi().toa());
+            }
+        }
+    }
+
+    LDMX_BENCHMARK(HgcrocTrigDigi_Compress) {
+        std::mt19937 rng(8);
+        std::uniform_int_distribution<uint32_t> adc(0, (1u << 18) - 1);
+        std::vector<uint32_t> linear(4096);
+        for (auto& l : linear) l = adc(rng) >> (rng() % 18);
+        state.setItemsPerIteration(linear.size());
+        while (state.keepRunning()) {
+            for (uint32_t l : linear) doNotOptimize(HgcrocTrigDigi::linear2Compressed(l));
+        }
+    }
+
+    LDMX_BENCHMARK(HgcrocTrigDigi_Decompress) {
+        std::vector<uint8_t> compressed(4096);
+        for (std::size_t i{0}; i < compressed.size(); ++i) compressed[i] = i % 128;
+        state.setItemsPerIteration(compressed.size());
+        while (state.keepRunning()) {
+            for (uint8_t c : compressed) doNotOptimize(HgcrocTrigDigi::compressed2Linear(c));
+        }
+    }
+
+} // bench
+} // ldmx
@@ -0,0 +1,106 @@
+/**
+ * @file ONNXRuntimeBenchmarks.cxx
+ * @brief Benchmarks of per-event and batched ONNXRuntime inference
+ *
+ * These need a model, given with the LDMX_BENCH_ONNX_MODEL environment
+ * variable. The model must have a single input; they are skipped otherwise.
+ */
+
+#include "Benchmarks/Benchmark.h"
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <cstdlib>
+#include <random>
+
+//----------//
+//   ldmx   //
+//----------//
+#include "Tools/ONNXRuntime.h"
+
+namespace ldmx {
+namespace bench {
+
+    namespace {
+
+        /// Number of samples inferred in each iteration
+        const int N_SAMPLES{256};
+
+        /**
+         * Load the model and prepare random inputs.
+         *
+         * @return the model, nullptr if the benchmark was skipped
+         */
+        std::unique_ptr<Ort::ONNXRuntime> loadModel(State& state, std::vector<std::vector<float>>& samples) {
+            const char* path{std::getenv("LDMX_BENCH_ONNX_MODEL")};
+            if (path == nullptr) {
+                state.skip("LDMX_BENCH_ONNX_MODEL not set");
+                return nullptr;
+            }
+
+            auto model{std::make_unique<Ort::ONNXRuntime>(path, 1, 0)};
+            if (model->getInputNames().size() != 1) {
+                state.skip("the model doesn't have a single input");
+                return nullptr;
+            }
+
+            std::size_t sampleSize{1};
+            const auto& shape{model->getInputShape(model->getInputNames().front())};
+            for (std::size_t i{1}; i < shape.size(); ++i) {
+                if (shape[i] <= 0) {
+                    state.skip("the input of the model has a dynamic dimension");
+                    return nullptr;
+                }
+                sampleSize *= shape[i];
+            }
+
+            std::mt19937 rng(9);
+            std::normal_distribution<float> value;
+            samples.assign(N_SAMPLES, std::vector<float>(sampleSize));
+            for (auto& sample : samples) for (float& v : sample) v = value(rng);
+            return model;
+        }
+
+    } // anonymous
+
+    LDMX_BENCHMARK(ONNXRuntime_PerEvent) {
+        std::vector<std::vector<float>> samples;
+        auto model{loadModel(state, samples)};
+        if (not model) return;
+
+        Ort::FloatArrays input(1);
+        state.setItemsPerIteration(N_SAMPLES);
+        while (state.keepRunning()) {
+            for (const auto& sample : samples) {
+                input[0] = sample;
+                doNotOptimize(model->run(model->getInputNames(), input));
+            }
+        }
+    }
+
+    LDMX_BENCHMARK_ARGS(ONNXRuntime_Batched, 16, 64, 256) {
+        std::vector<std::vector<float>> samples;
+        auto model{loadModel(state, samples)};
+        if (not model) return;
+
+        Ort::ONNXRuntime::Batch batch(*model, state.arg());
+        Ort::FloatArrays input(1);
+        state.setItemsPerIteration(N_SAMPLES);
+        while (state.keepRunning()) {
+            for (const auto& sample : samples) {
+                input[0] = sample;
+                batch.add(input);
+                if (batch.full()) {
+                    batch.run();
+                    doNotOptimize(batch.output(0, 0));
+                    batch.clear();
+                }
+            }
+            batch.run();
+            batch.clear();
+        }
+    }
+
+} // bench
+} // ldmx
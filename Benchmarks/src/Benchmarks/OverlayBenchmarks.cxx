@@ -0,0 +1,77 @@
+/**
+ * @file OverlayBenchmarks.cxx
+ * @brief Benchmarks of the pileup overlay merging
+ */
+
+#include "Benchmarks/Benchmark.h"
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <map>
+#include <random>
+#include <vector>
+
+//----------//
+//   ldmx   //
+//----------//
+#include "DetDescr/EcalID.h"
+#include "Recon/OverlayProducer.h"
+#include "SimCore/Event/SimCalorimeterHit.h"
+
+namespace ldmx {
+namespace bench {
+
+    namespace {
+
+        /// Number of Ecal hits in the sim event
+        const std::size_t N_SIM_HITS{2000};
+
+        /// Number of Ecal hits in each overlay event
+        const std::size_t N_OVERLAY_HITS{500};
+
+        /// Ecal sim hits on random channels of the v12 Ecal (34 layers, 7 modules, 432 cells)
+        std::vector<SimCalorimeterHit> randomEcalSimHits(std::size_t n, std::mt19937& rng) {
+            std::uniform_int_distribution<int> layer(0, 33), module(0, 6), cell(0, 431);
+            std::uniform_real_distribution<float> xy(-250., 250.), z(240., 680.), edep(0.01, 5.), time(0., 20.);
+            std::vector<SimCalorimeterHit> hits(n);
+            for (auto& hit : hits) {
+                hit.setID(EcalID(layer(rng), module(rng), cell(rng)).raw());
+                hit.setPosition(xy(rng), xy(rng), z(rng));
+                hit.setEdep(edep(rng));
+                hit.setTime(time(rng));
+            }
+            return hits;
+        }
+
+    } // anonymous
+
+    /**
+     * Merge state.arg() overlay events into the Ecal hits of a sim event as
+     * contribs, then flatten the hit map into the output collection, as
+     * OverlayProducer::produce does for the Ecal collections.
+     */
+    LDMX_BENCHMARK_ARGS(OverlayProducer_EcalContribs, 1, 10, 50) {
+        std::mt19937 rng(7);
+        auto simHits{randomEcalSimHits(N_SIM_HITS, rng)};
+        std::vector<std::vector<SimCalorimeterHit>> overlayEvents;
+        for (long i{0}; i < state.arg(); ++i) overlayEvents.push_back(randomEcalSimHits(N_OVERLAY_HITS, rng));
+        std::uniform_real_distribution<float> timeOffset(-10., 10.);
+
+        std::map<int, SimCalorimeterHit> hitMap;
+        std::vector<SimCalorimeterHit> merged;
+        state.setItemsPerIteration(N_SIM_HITS + state.arg()*N_OVERLAY_HITS);
+        while (state.keepRunning()) {
+            hitMap.clear();
+            for (const auto& hit : simHits) hitMap[hit.getID()] = hit;
+            for (const auto& overlayHits : overlayEvents) {
+                OverlayProducer::addOverlayContribs(overlayHits, timeOffset(rng), -1000, -1000, 0, hitMap);
+            }
+            merged.clear();
+            for (const auto& [id, hit] : hitMap) merged.push_back(hit);
+            doNotOptimize(merged.data());
+        }
+    }
+
+} // bench
+} // ldmx
@@ -5,6 +5,17 @@
 #include "Framework/EventProcessor.h" //Needed to declare processor
 #include "Framework/Configure/Parameters.h" // Needed to import parameters from configuration file
 
+//DQM
+#include "DQM/HistogramHandle.h"
+#include "DQM/HistogramSnapshots.h"
+
+//LDMX Event
+#include "Ecal/Event/EcalHit.h"
+#include "SimCore/Event/SimCalorimeterHit.h"
+
+//STL
+#include <vector>
+
 namespace ldmx {
     
     /**
@@ -27,6 +38,16 @@ namespace ldmx {
              */
             virtual void configure(Parameters& ps);
 
+            /**
+             * Resolve the histogram handles
+             */
+            virtual void onProcessStart();
+
+            /**
+             * Fill the values left in the histogram buffers
+             */
+            virtual void onProcessEnd();
+
             /**
              * Fills histograms
              */
@@ -34,6 +55,12 @@ namespace ldmx {
 
         private:
 
+            /// Buffers for the histogram fills
+            HistogramBuffers buffers_;
+
+            /// Periodic snapshots of the histograms in online mode
+            HistogramSnapshots snapshots_;
+
             /// Collection Name for SimHits
             std::string ecalSimHitColl_;
 
@@ -46,6 +73,21 @@ namespace ldmx {
             /// Pass Name for RecHits
             std::string ecalRecHitPass_;
 
+            /// Number of sim hits per cell with a rec hit
+            Hist1D numSimHitsPerCell_;
+
+            /// Sim energy deposited vs rec amplitude per cell
+            Hist2D simEdepRecAmplitude_;
+
+            /// Total rec energy per event
+            Hist1D totalRecEnergy_;
+
+            /// Sim hits of the current event sorted by ID, kept to reuse the allocation
+            std::vector<const SimCalorimeterHit*> simHitsByID_;
+
+            /// Non-noise rec hits of the current event sorted by ID, kept to reuse the allocation
+            std::vector<const EcalHit*> recHitsByID_;
+
     };
 }
 
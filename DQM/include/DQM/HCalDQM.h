@@ -19,6 +19,9 @@
 #include "Framework/Configure/Parameters.h" 
 
 #include "Tools/AnalysisUtils.h"
+#include "DQM/HistogramHandle.h"
+#include "DQM/HistogramSnapshots.h"
+#include "DQM/SummaryNtuple.h"
 
 namespace ldmx { 
 
@@ -46,10 +49,44 @@ namespace ldmx {
              */
             void analyze(const Event& event);
 
+            /** Method executed before processing of events begins. */
+            void onProcessStart();
+
+            /** Method executed after processing of events ends. */
+            void onProcessEnd();
+
         private:
 
+            /** Buffers for the histogram fills. */
+            HistogramBuffers buffers_;
+
+            /** Periodic snapshots of the histograms in online mode. */
+            HistogramSnapshots snapshots_;
+
             /** The maximum PE threshold used for the veto. */
             float maxPEThreshold_{5}; 
+
+            /** Handles to the histograms filled for every event. */
+            Hist1D nHits_, pe_, hitTime_, totalPE_, minTimeHitAboveThresh_; 
+            Hist2D minTimeHitAboveThreshPE_;
+
+            /** Handles to the histograms filled if the HcalVeto result exists. */
+            Hist1D maxPE_, hitTimeMaxPE_, veto_;
+            Hist2D maxPETime_;
+
+            /** Handles to the histograms filled if the event passes the HcalVeto. */
+            Hist1D maxPEHcalVeto_, hitTimeMaxPEHcalVeto_, totalPEHcalVeto_, nHitsHcalVeto_;
+            Hist2D maxPETimeHcalVeto_;
+
+            /** Per-event summary ntuple, only written if enabled. */
+            SummaryNtuple ntuple_;
+
+            /** Values written to the summary ntuple. */
+            struct {
+                int nHits;
+                float totalPE, minTimeHitAboveThresh, maxPE, maxPETime;
+                bool passesVeto;
+            } summary_;
             
     };    
     
@@ -0,0 +1,330 @@
+/**
+ * @file HistogramHandle.h
+ * @brief Cached handles to the histograms of a DQM analyzer
+ */
+
+#ifndef DQM_HISTOGRAMHANDLE_H
+#define DQM_HISTOGRAMHANDLE_H
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+//----------//
+//   ROOT   //
+//----------//
+#include "TH1.h"
+#include "TH2.h"
+
+/*~~~~~~~~~~~~~~~*/
+/*   Framework   */
+/*~~~~~~~~~~~~~~~*/
+#include "Framework/Exception/Exception.h"
+
+namespace ldmx {
+
+    /**
+     * @class HistogramBuffers
+     * @brief Buffered filling for the histogram handles of one analyzer
+     *
+     * Handles resolved with a HistogramBuffers append their values to
+     * per-thread buffers (one array per coordinate) and only fill the
+     * histogram, with a single TH1::FillN under a lock, when the buffer
+     * of the filling thread is full. Threads never touch the same buffer,
+     * so filling doesn't serialize on the shared histograms.
+     *
+     * The analyzer owns one of these, sets the buffer size in configure,
+     * and calls flush in onProcessEnd so no values are left behind.
+     */
+    class HistogramBuffers {
+
+        public:
+
+            /// Maximum number of threads that can fill buffered handles at the same time
+            static constexpr unsigned int MAX_THREADS{64};
+
+            /**
+             * Set the number of values kept per thread before filling.
+             *
+             * A size of 0 or 1 turns buffering off and handles fill directly.
+             * Only affects handles resolved after this call.
+             *
+             * @param[in] size number of values per thread and histogram
+             */
+            void setBufferSize(int size) { size_ = size > 1 ? size : 0; }
+
+            /// @return the number of values kept per thread before filling, 0 if not buffering
+            std::size_t getBufferSize() const { return size_; }
+
+            /**
+             * Fill all of the buffered values into their histograms.
+             *
+             * Must not be called while other threads are filling.
+             */
+            void flush() {
+                for (auto& buffer : buffers_) buffer->flushAll();
+            }
+
+            /**
+             * @class Buffer
+             * @brief Per-thread buffers of a single histogram
+             */
+            class Buffer {
+
+                public:
+
+                    virtual ~Buffer() = default;
+
+                    /// Fill all threads' values into the histogram
+                    virtual void flushAll() = 0;
+            };
+
+            /**
+             * Keep a buffer so it is flushed with the others.
+             *
+             * @param[in] buffer buffer of a newly resolved handle
+             */
+            void add(std::shared_ptr<Buffer> buffer) { buffers_.push_back(buffer); }
+
+            /**
+             * Index of the calling thread among the filling threads.
+             *
+             * The index is taken the first time a thread fills and given back
+             * when the thread exits, so only the threads alive at the same time
+             * count against MAX_THREADS. A thread taking over an index also
+             * takes over the values left in its buffers, which are filled as
+             * usual.
+             *
+             * @throw Exception if more than MAX_THREADS threads fill at the same time.
+             */
+            static unsigned int threadIndex() {
+                thread_local ThreadSlot slot;
+                return slot.index;
+            }
+
+        private:
+
+            /**
+             * @struct ThreadSlot
+             * @brief Index held by a filling thread for its lifetime
+             */
+            struct ThreadSlot {
+                ThreadSlot() {
+                    std::lock_guard<std::mutex> lock(slotMutex_);
+                    if (!freeSlots_.empty()) {
+                        index = freeSlots_.back();
+                        freeSlots_.pop_back();
+                    } else if (nextSlot_ < MAX_THREADS) {
+                        index = nextSlot_++;
+                    } else {
+                        EXCEPTION_RAISE("HistogramBuffers", "More than " + std::to_string(MAX_THREADS)
+                                + " threads are filling buffered histograms at the same time.");
+                    }
+                }
+
+                ~ThreadSlot() {
+                    std::lock_guard<std::mutex> lock(slotMutex_);
+                    freeSlots_.push_back(index);
+                }
+
+                unsigned int index{0};
+            };
+
+            /// guards the thread indices
+            static inline std::mutex slotMutex_;
+
+            /// indices given back by threads that exited
+            static inline std::vector<unsigned int> freeSlots_;
+
+            /// next index never handed out
+            static inline unsigned int nextSlot_{0};
+
+            /// number of values kept per thread before filling
+            std::size_t size_{0};
+
+            /// buffers of all of the resolved handles
+            std::vector<std::shared_ptr<Buffer>> buffers_;
+    };
+
+    /**
+     * @class HistogramHandle
+     * @brief Pointer to a histogram that is looked up by name only once
+     *
+     * Filling through histograms_.fill("name",...) builds a string and
+     * searches the histogram pool on every call. Analyzers instead resolve
+     * a handle for each of their histograms in onProcessStart (after the
+     * histograms have been created) and fill through the handle in analyze.
+     *
+     * The histogram is still owned by the analyzer's histogram helper.
+     *
+     * @tparam HistType TH1 for one-dimensional histograms, TH2 for two-dimensional
+     */
+    template<class HistType>
+    class HistogramHandle {
+
+        public:
+
+            /// Empty handle, must be resolved before filling
+            HistogramHandle() = default;
+
+            /**
+             * Resolve the handle to the histogram with the input name.
+             *
+             * @throw Exception if the histogram doesn't exist or has the wrong dimension.
+             *
+             * @param[in] histograms histogram helper of the analyzer
+             * @param[in] name name of the histogram
+             */
+            template<class Helper>
+            HistogramHandle(Helper& histograms, const std::string& name)
+                : hist_{dynamic_cast<HistType*>(histograms.get(name))} {
+                if (!hist_) {
+                    EXCEPTION_RAISE("HistogramHandle", "Histogram '" + name
+                            + "' does not exist or is not a " + HistType::Class_Name() + ".");
+                }
+                // TH2 and TH3 derive from TH1, so the cast alone doesn't
+                // catch a 1D handle on a histogram with more dimensions
+                if (hist_->GetDimension() != int(DIM)) {
+                    EXCEPTION_RAISE("HistogramHandle", "Histogram '" + name + "' has "
+                            + std::to_string(hist_->GetDimension()) + " dimensions but the handle fills "
+                            + std::to_string(DIM) + ".");
+                }
+            }
+
+            /**
+             * Resolve the handle and fill through the input buffers.
+             *
+             * @param[in] histograms histogram helper of the analyzer
+             * @param[in] name name of the histogram
+             * @param[in] buffers buffers of the analyzer, unbuffered if the size is 0
+             */
+            template<class Helper>
+            HistogramHandle(Helper& histograms, const std::string& name, HistogramBuffers& buffers)
+                : HistogramHandle(histograms, name) {
+                if (buffers.getBufferSize() > 0) {
+                    buffer_ = std::make_shared<Buffer>(hist_, buffers.getBufferSize());
+                    buffers.add(buffer_);
+                }
+            }
+
+            /**
+             * Fill the histogram
+             *
+             * The arguments are passed on to HistType::Fill,
+             * e.g. (x) for a TH1 and (x,y) for a TH2.
+             * Buffered handles only take the coordinates, no weight.
+             */
+            template<typename... Args>
+            void fill(Args... args) const {
+                if (buffer_) buffer_->push(args...);
+                else hist_->Fill(args...);
+            }
+
+            /// @return the histogram this handle points to
+            HistType* get() const { return hist_; }
+
+        private:
+
+            /// number of coordinates of the histogram
+            static constexpr std::size_t DIM{std::is_base_of<TH2,HistType>::value ? 2 : 1};
+
+            /**
+             * @class Buffer
+             * @brief Per-thread coordinate arrays of one histogram
+             */
+            class Buffer : public HistogramBuffers::Buffer {
+
+                public:
+
+                    Buffer(HistType* hist, std::size_t size) : hist_{hist}, size_{size} { }
+
+                    ~Buffer() {
+                        for (auto& local : values_) delete local.load();
+                    }
+
+                    /// Add a value from the calling thread, filling if its buffer is full
+                    template<typename... Coords>
+                    void push(Coords... coords) {
+                        static_assert(sizeof...(Coords) == DIM, "Buffered handles take one value per histogram dimension.");
+                        auto& local{localValues(HistogramBuffers::threadIndex()).coords};
+                        std::size_t i{0};
+                        ((local[i++].push_back(coords)), ...);
+                        if (local[0].size() >= size_) flush(local);
+                    }
+
+                    /// Fill all threads' values into the histogram
+                    void flushAll() final override {
+                        for (auto& local : values_) {
+                            if (Local* values = local.load(std::memory_order_acquire)) flush(values->coords);
+                        }
+                    }
+
+                private:
+
+                    /// values of each coordinate from one thread, on its own cache line
+                    struct alignas(64) Local {
+                        std::array<std::vector<double>,DIM> coords;
+                    };
+
+                    /**
+                     * Values of the thread with the input index, created the
+                     * first time that index fills this histogram. Only the
+                     * thread holding the index creates them, so no lock is needed.
+                     */
+                    Local& localValues(unsigned int index) {
+                        Local* values{values_[index].load(std::memory_order_acquire)};
+                        if (!values) {
+                            values = new Local;
+                            values_[index].store(values, std::memory_order_release);
+                        }
+                        return *values;
+                    }
+
+                    /// Fill the values of one thread and clear them
+                    void flush(std::array<std::vector<double>,DIM>& local) {
+                        if (local[0].empty()) return;
+                        {
+                            std::lock_guard<std::mutex> lock(mutex_);
+                            int n = local[0].size();
+                            if constexpr (DIM == 1) hist_->FillN(n, local[0].data(), nullptr);
+                            else hist_->FillN(n, local[0].data(), local[1].data(), nullptr);
+                        }
+                        for (auto& coord : local) coord.clear();
+                    }
+
+                    /// histogram to fill
+                    HistType* hist_;
+
+                    /// number of values per thread before filling
+                    std::size_t size_;
+
+                    /// serializes the fills into the histogram
+                    std::mutex mutex_;
+
+                    /// values from each thread index, null until that index fills
+                    std::array<std::atomic<Local*>,HistogramBuffers::MAX_THREADS> values_{};
+            };
+
+            /// histogram owned by the histogram helper
+            HistType* hist_{nullptr};
+
+            /// buffers shared by the copies of this handle, null if unbuffered
+            std::shared_ptr<Buffer> buffer_;
+    };
+
+    /// Handle to a one-dimensional histogram
+    typedef HistogramHandle<TH1> Hist1D;
+
+    /// Handle to a two-dimensional histogram
+    typedef HistogramHandle<TH2> Hist2D;
+
+} // ldmx
+
+#endif // DQM_HISTOGRAMHANDLE_H
@@ -0,0 +1,162 @@
+/**
+ * @file HistogramSnapshots.h
+ * @brief Periodic snapshots of the histograms of a DQM analyzer
+ */
+
+#ifndef DQM_HISTOGRAMSNAPSHOTS_H
+#define DQM_HISTOGRAMSNAPSHOTS_H
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <chrono>
+#include <string>
+#include <thread>
+
+//----------//
+//   ROOT   //
+//----------//
+#include "TDirectory.h"
+
+/*~~~~~~~~~~~~~~~*/
+/*   Framework   */
+/*~~~~~~~~~~~~~~~*/
+#include "Framework/Configure/Parameters.h"
+
+#include "DQM/HistogramHandle.h"
+
+namespace ldmx {
+
+    /**
+     * @class HistogramSnapshots
+     * @brief Online mode of a DQM analyzer
+     *
+     * Writes the current state of the histograms of an analyzer to a local
+     * file every N events and/or every T seconds while the event loop keeps
+     * running, so long jobs can be monitored before they end.
+     *
+     * Each snapshot is written to a temporary file which is then renamed
+     * over the target, so a consumer polling the file never reads a partial
+     * snapshot. With more than one file, the snapshots rotate through
+     * <file>_0.root, <file>_1.root, ...
+     *
+     * Snapshot cost is bounded: after a snapshot taking a time t, the next
+     * one is held back until the event loop has run for at least
+     * t*(1/max_fraction - 1), so snapshots never take more than max_fraction
+     * of the wall time. The number, mean and maximum time of the snapshots
+     * are printed at the end of processing.
+     *
+     * Online mode is single-threaded only: a snapshot flushes the buffers of
+     * every thread and reads the histograms while the event loop is paused,
+     * which is only safe if no other thread is filling. The analyzer must
+     * therefore always be run from the same thread; update throws otherwise.
+     */
+    class HistogramSnapshots {
+
+        public:
+
+            /**
+             * Configure the snapshots from the analyzer parameters.
+             *
+             * Snapshots are off if both snapshot_events and snapshot_seconds are 0.
+             *
+             * @param[in] parameters parameters of the analyzer
+             * @param[in] name name of the analyzer, used in printouts
+             */
+            void configure(Parameters& parameters, const std::string& name);
+
+            /**
+             * Start taking snapshots.
+             *
+             * Called in onProcessStart, after the histograms have been
+             * created and the handles resolved.
+             *
+             * @param[in] dir histogram directory of the analyzer
+             * @param[in] buffers buffered fills to flush before each snapshot
+             */
+            void start(TDirectory* dir, HistogramBuffers& buffers);
+
+            /**
+             * Count an event and take a snapshot if one is due.
+             *
+             * Called at the start of analyze, before any early return.
+             *
+             * @throw Exception if called from another thread than the first event.
+             */
+            void update() {
+                if (!enabled_) return;
+                if (thread_ != std::this_thread::get_id()) checkThread();
+                ++nEvents_;
+                if (everyEvents_ > 0 and nEvents_ - lastEvents_ >= everyEvents_) snapshot();
+                else if (everySeconds_.count() > 0 and Clock::now() - last_ >= everySeconds_) snapshot();
+            }
+
+            /**
+             * Print the cost of the snapshots.
+             *
+             * Called in onProcessEnd.
+             */
+            void finish();
+
+        private:
+
+            typedef std::chrono::steady_clock Clock;
+
+            /// Write the current histograms to the next file, unless held back by the cost bound
+            void snapshot();
+
+            /// Take the calling thread as the analyzing thread on the first event, throw on a later one
+            void checkThread();
+
+            /// true if snapshots are taken
+            bool enabled_{false};
+
+            /// name of the analyzer
+            std::string name_;
+
+            /// number of events between snapshots, 0 if not counting events
+            long everyEvents_{0};
+
+            /// time between snapshots, 0 if not timing
+            std::chrono::duration<double> everySeconds_{0};
+
+            /// snapshot file path, without the .root extension
+            std::string file_;
+
+            /// number of files the snapshots rotate through
+            int nFiles_{1};
+
+            /// maximum fraction of the wall time spent on snapshots
+            double maxFraction_{0.01};
+
+            /// histogram directory of the analyzer
+            TDirectory* dir_{nullptr};
+
+            /// buffered fills of the analyzer
+            HistogramBuffers* buffers_{nullptr};
+
+            /// thread running the analyzer, unset until the first event
+            std::thread::id thread_;
+
+            /// number of events seen
+            long nEvents_{0};
+
+            /// number of events seen at the last snapshot
+            long lastEvents_{0};
+
+            /// time of the last snapshot
+            Clock::time_point last_;
+
+            /// no snapshot is taken before this time
+            Clock::time_point notBefore_;
+
+            /// number of snapshots taken
+            int nSnapshots_{0};
+
+            /// total and maximum time spent taking snapshots
+            std::chrono::duration<double> totalTime_{0}, maxTime_{0};
+    };
+
+} // ldmx
+
+#endif // DQM_HISTOGRAMSNAPSHOTS_H
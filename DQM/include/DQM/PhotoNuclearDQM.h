@@ -1,12 +1,22 @@
 #ifndef DQM_PHOTONUCLEARDQM_H
 #define DQM_PHOTONUCLEARDQM_H
 
+/*~~~~~~~~~~~~~~~~*/
+/*   C++ StdLib   */
+/*~~~~~~~~~~~~~~~~*/
+#include <map>
+#include <vector>
+
 /*~~~~~~~~~~~~~~~*/
 /*   Framework   */
 /*~~~~~~~~~~~~~~~*/
 #include "Framework/EventProcessor.h"
 #include "Framework/Configure/Parameters.h" 
 
+#include "DQM/HistogramHandle.h"
+#include "DQM/HistogramSnapshots.h"
+#include "DQM/SummaryNtuple.h"
+
 namespace ldmx { 
 
     // Forward declarations within the ldmx workspace
@@ -41,14 +51,59 @@ namespace ldmx {
             /// Method executed before processing of events begins. 
             void onProcessStart();
 
+            /// Method executed after processing of events ends. 
+            void onProcessEnd();
+
         private:
 
+            /** Buffers for the histogram fills. */
+            HistogramBuffers buffers_;
+
+            /** Periodic snapshots of the histograms in online mode. */
+            HistogramSnapshots snapshots_;
+
+            /**
+             * Kinematics of a PN daughter, computed once per event.
+             */
+            struct Daughter {
+                /// The daughter particle
+                const SimParticle* particle;
+                /// Kinetic energy (MeV)
+                double ke;
+                /// Polar angle (degrees)
+                double theta;
+                /// Absolute value of the PDG ID
+                int pdgID;
+            };
+
+            /**
+             * Multiplicities of the PN daughters above a kinetic energy threshold.
+             */
+            struct Multiplicities {
+                short n{0}, p{0}, pi{0}, pi0{0}, exotic{0}, k0l{0}, kp{0}, k0s{0};
+
+                /// Count the input daughter
+                void add(const Daughter& daughter);
+            };
+
+            /**
+             * Counts used by the compact classification.
+             */
+            struct CompactCounts {
+                /// Daughters carrying at least 80% of the PN photon energy
+                short n{0}, k0l{0}, kp{0}, k0s{0};
+                /// Daughters below 500 MeV
+                std::size_t soft{0};
+                /// Neutrons between 500 MeV and 80% of the PN photon energy above the threshold
+                short n_t{0};
+            };
+
             /**
              * Print the particle tree.
              * 
              * @param[in] particleMap The map containing the SimParticles.
              */
-            void printParticleTree(std::map< int, SimParticle > particleMap);
+            void printParticleTree(const std::map< int, SimParticle > &particleMap);
 
             /**
              * Print the daughters of a particle.
@@ -60,14 +115,88 @@ namespace ldmx {
              * @return[out] A vector with the track IDs of particles that have 
              *      already been printed.
              */
-            std::vector< int > printDaughters(std::map< int, SimParticle > particleMap, const SimParticle particle, int depth);  
+            std::vector< int > printDaughters(const std::map< int, SimParticle > &particleMap, const SimParticle &particle, int depth);  
 
-            /** Method used to classify events. */
-            int classifyEvent(const std::vector< const SimParticle* > daughters, double threshold); 
+            /** Method used to classify events from the multiplicities above a threshold. */
+            int classifyEvent(const Multiplicities &m); 
 
             /** Method used to classify events in a compact manner. */
-            int classifyCompactEvent(const SimParticle* pnGamma, 
-                                     const std::vector< const SimParticle* > daughters, double threshold); 
+            int classifyCompactEvent(const CompactCounts &c, std::size_t nDaughters); 
+
+            /** PN daughters of the current event, sorted by decreasing kinetic energy. */
+            std::vector< Daughter > pnDaughters_; 
+
+            /** Handles to the recoil electron vertex histograms. */
+            Hist1D recoilVertexX_;
+            Hist1D recoilVertexY_;
+            Hist1D recoilVertexZ_;
+            Hist2D recoilVertexXY_;
+
+            /** Handles to the PN photon histograms. */
+            Hist1D pnParticleMult_;
+            Hist1D pnGammaEnergy_;
+            Hist1D pnGammaIntZ_;
+            Hist1D pnGammaVertexX_;
+            Hist1D pnGammaVertexY_;
+            Hist1D pnGammaVertexZ_;
+
+            /** Handles to the hardest PN daughters histograms. */
+            Hist1D hardestKE_;
+            Hist1D hardestTheta_;
+            Hist2D hardestKETheta_;
+            Hist1D hardestProtonKE_;
+            Hist1D hardestProtonTheta_;
+            Hist1D hardestNeutronKE_;
+            Hist1D hardestNeutronTheta_;
+            Hist1D hardestPionKE_;
+            Hist1D hardestPionTheta_;
+
+            /** Handles to the event classification histograms. */
+            Hist1D eventType_;
+            Hist1D eventType500MeV_;
+            Hist1D eventType2000MeV_;
+            Hist1D eventTypeCompact_;
+            Hist1D eventTypeCompact500MeV_;
+            Hist1D eventTypeCompact2000MeV_;
+
+            /** Handles to the single neutron events histograms. */
+            Hist2D neutronKE2ndHardestKE_;
+            Hist1D neutronEnergy_;
+            Hist1D neutronEnergyDiff_;
+            Hist1D neutronEnergyFrac_;
+
+            /** Handles to the di-neutron events histograms. */
+            Hist1D dineutronN2Energy_;
+            Hist1D dineutronEnergyFrac_;
+            Hist1D dineutronEnergyOther_;
+
+            /** Handles to the charged kaon events histograms. */
+            Hist2D chargedKaonKE2ndHardestKE_;
+            Hist1D chargedKaonEnergy_;
+            Hist1D chargedKaonEnergyDiff_;
+            Hist1D chargedKaonEnergyFrac_;
+
+            /** Handles to the neutral kaon events histograms. */
+            Hist2D neutralKaonKE2ndHardestKE_;
+            Hist1D neutralKaonEnergy_;
+            Hist1D neutralKaonEnergyDiff_;
+            Hist1D neutralKaonEnergyFrac_;
+
+            /** Handles to the leading particle type histograms. */
+            Hist1D neutronEventType_;
+
+            /** Per-event summary ntuple, only written if enabled. */
+            SummaryNtuple ntuple_;
+
+            /** Values written to the summary ntuple for every event with a PN photon. */
+            struct {
+                float recoilVertexX, recoilVertexY, recoilVertexZ;
+                int pnParticleMult;
+                float pnGammaEnergy, pnGammaIntZ;
+                float hardestKE, hardestTheta, hardestProtonKE, hardestNeutronKE, hardestPionKE;
+                int eventType, eventType500MeV, eventType2000MeV;
+                int eventTypeCompact, eventTypeCompact500MeV, eventTypeCompact2000MeV;
+            } summary_;
 
     };    
     
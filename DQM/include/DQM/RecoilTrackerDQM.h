@@ -17,6 +17,9 @@
 //   LDMX   //
 //----------//
 #include "Tools/AnalysisUtils.h"
+#include "DQM/HistogramHandle.h"
+#include "DQM/HistogramSnapshots.h"
+#include "DQM/SummaryNtuple.h"
 
 /*~~~~~~~~~~~~~~~*/
 /*   Framework   */
@@ -54,6 +57,32 @@ namespace ldmx {
             /** Method executed before processing of events begins. */
             void onProcessStart();
 
+            /** Method executed after processing of events ends. */
+            void onProcessEnd();
+
+        private:
+
+            /** Buffers for the histogram fills. */
+            HistogramBuffers buffers_;
+
+            /** Periodic snapshots of the histograms in online mode. */
+            HistogramSnapshots snapshots_;
+
+            /** Handles to the recoil truth momentum histograms for all events. */
+            Hist1D tp_, tpt_, tpx_, tpy_, tpz_; 
+
+            /** Handles to the recoil truth momentum histograms for events passing the tracker veto. */
+            Hist1D tpTrackVeto_, tptTrackVeto_, tpxTrackVeto_, tpyTrackVeto_, tpzTrackVeto_; 
+
+            /** Per-event summary ntuple, only written if enabled. */
+            SummaryNtuple ntuple_;
+
+            /** Values written to the summary ntuple. */
+            struct {
+                float p, pt, px, py, pz;
+                bool passesTrackVeto;
+            } summary_;
+
     }; // RecoilTrackerDQM 
     
 } // ldmx
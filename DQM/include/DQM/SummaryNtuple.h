@@ -0,0 +1,133 @@
+/**
+ * @file SummaryNtuple.h
+ * @brief Flat per-event ntuple written next to the histograms of a DQM analyzer
+ */
+
+#ifndef DQM_SUMMARYNTUPLE_H
+#define DQM_SUMMARYNTUPLE_H
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <string>
+#include <type_traits>
+
+//----------//
+//   ROOT   //
+//----------//
+#include "TDirectory.h"
+#include "TTree.h"
+
+/*~~~~~~~~~~~~~~~*/
+/*   Framework   */
+/*~~~~~~~~~~~~~~~*/
+#include "Framework/Exception/Exception.h"
+
+namespace ldmx {
+
+    /**
+     * @class SummaryNtuple
+     * @brief Compact TTree of per-event summary quantities
+     *
+     * The histograms of an analyzer have their binning fixed in the python
+     * configuration, so a binning change means running over the sample
+     * again. An analyzer can instead (or in addition) write one entry per
+     * event holding its summary quantities into a flat tree with one
+     * scalar branch per quantity. The histograms can then be rebuilt
+     * offline with any binning, e.g. tree->Draw("total_pe>>h(300,0,3000)").
+     *
+     * The tree is created in the histogram directory of the analyzer and is
+     * written with the histograms. The analyzer keeps the values in its own
+     * members, connects them with branch in onProcessStart, and calls fill
+     * once per event after setting them.
+     */
+    class SummaryNtuple {
+
+        public:
+
+            /**
+             * Turn the ntuple on or off.
+             *
+             * Only affects ntuples booked after this call.
+             *
+             * @param[in] enable true if the ntuple should be written
+             * @param[in] basketSize size of the branch buffers in bytes,
+             *                       ROOT default if 0 or less
+             */
+            void setEnabled(bool enable, int basketSize = 0) {
+                enabled_ = enable;
+                basketSize_ = basketSize;
+            }
+
+            /// @return true if the ntuple is booked and filled
+            bool enabled() const { return tree_ != nullptr; }
+
+            /**
+             * Create the tree in the input directory.
+             *
+             * Does nothing if the ntuple is not enabled.
+             *
+             * @param[in] dir histogram directory of the analyzer
+             * @param[in] name name of the tree
+             * @param[in] title title of the tree
+             */
+            void book(TDirectory* dir, const std::string& name, const std::string& title) {
+                if (!enabled_) return;
+                tree_ = new TTree(name.c_str(), title.c_str());
+                tree_->SetDirectory(dir);
+            }
+
+            /**
+             * Connect a branch to an analyzer member.
+             *
+             * The member is read at every fill, so it must outlive the ntuple.
+             *
+             * @tparam T float, double, int, unsigned int, short or bool
+             * @param[in] name name of the branch
+             * @param[in] value member holding the value of the current event
+             */
+            template<typename T>
+            void branch(const std::string& name, T& value) {
+                if (!tree_) return;
+                auto branch = tree_->Branch(name.c_str(), &value, (name + "/" + leafType<T>()).c_str());
+                if (!branch) {
+                    EXCEPTION_RAISE("SummaryNtuple", "Unable to create branch '" + name
+                            + "' in " + tree_->GetName() + ".");
+                }
+                if (basketSize_ > 0) branch->SetBasketSize(basketSize_);
+            }
+
+            /// Write the current values of all branches as a new entry
+            void fill() {
+                if (tree_) tree_->Fill();
+            }
+
+        private:
+
+            /// @return the ROOT leaf type code for T
+            template<typename T>
+            static constexpr char leafType() {
+                if constexpr (std::is_same<T,float>::value) return 'F';
+                else if constexpr (std::is_same<T,double>::value) return 'D';
+                else if constexpr (std::is_same<T,int>::value) return 'I';
+                else if constexpr (std::is_same<T,unsigned int>::value) return 'i';
+                else if constexpr (std::is_same<T,short>::value) return 'S';
+                else {
+                    static_assert(std::is_same<T,bool>::value, "Unsupported summary ntuple branch type.");
+                    return 'O';
+                }
+            }
+
+            /// true if the tree should be created when booking
+            bool enabled_{false};
+
+            /// size of the branch buffers in bytes
+            int basketSize_{0};
+
+            /// the tree, owned by the histogram directory
+            TTree* tree_{nullptr};
+    };
+
+} // ldmx
+
+#endif // DQM_SUMMARYNTUPLE_H
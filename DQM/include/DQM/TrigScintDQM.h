@@ -25,6 +25,8 @@
 #include "Framework/EventProcessor.h"
 #include "DetDescr/TrigScintID.h"
 #include "Tools/AnalysisUtils.h"
+#include "DQM/HistogramHandle.h"
+#include "DQM/HistogramSnapshots.h"
 
 namespace ldmx { 
 
@@ -55,13 +57,28 @@ namespace ldmx {
             /** Method executed before processing of events begins. */
             void onProcessStart();
 
+            /** Method executed after processing of events ends. */
+            void onProcessEnd();
+
         private:
 
+            /** Buffers for the histogram fills. */
+            HistogramBuffers buffers_;
+
+            /** Periodic snapshots of the histograms in online mode. */
+            HistogramSnapshots snapshots_;
+
             /// Name of trigger pad hit  collection.
             std::string hitCollectionName_{"TriggerPadUpSimHits"}; 
 
             /// Name of Pad
 	        std::string padName_{"_up"}; 
+
+            /// Handles to the per-event histograms
+            Hist1D nHits_, totalEnergy_;
+
+            /// Handles to the per-hit histograms
+            Hist1D energy_, hitTime_, id_, x_, y_, z_;
     };    
     
 } // ldmx
@@ -20,6 +20,8 @@
 #include "Framework/EventProcessor.h"
 #include "Tools/AnalysisUtils.h"
 #include "TrigScint/Event/TrigScintHit.h"
+#include "DQM/HistogramHandle.h"
+#include "DQM/HistogramSnapshots.h"
 
 namespace ldmx { 
 
@@ -50,12 +52,27 @@ namespace ldmx {
             /** Method executed before processing of events begins. */
             void onProcessStart();
 
+            /** Method executed after processing of events ends. */
+            void onProcessEnd();
+
         private:
 
+            /** Buffers for the histogram fills. */
+            HistogramBuffers buffers_;
+
+            /** Periodic snapshots of the histograms in online mode. */
+            HistogramSnapshots snapshots_;
+
             /** Name of trigger pad hit  collection. */
             std::string hitCollectionName_{"TriggerPadUpDigiHits"}; 
 	        std::string padName_{"_up"}; 
 
+            /** Handles to the per-event histograms. */
+            Hist1D nHits_, totalPE_, nHitsNoise_;
+
+            /** Handles to the per-hit histograms. */
+            Hist1D pe_, hitTime_, id_, peNoise_, idNoise_, x_, y_, z_;
+
     };    
     
 } // ldmx
@@ -2,7 +2,57 @@
 
 from LDMX.Framework import ldmxcfg
 
-class EcalDigiVerify(ldmxcfg.Analyzer) :
+class DQMAnalyzer(ldmxcfg.Analyzer) :
+    """Parameters shared by all of the DQM analyzers
+
+    Parameters
+    ----------
+    histogram_buffer_size : int
+        Values kept per histogram and thread before filling, 0 fills directly
+    snapshot_events : int
+        Snapshot the histograms every this many events, 0 to not count events
+    snapshot_seconds : float
+        Snapshot the histograms every this many seconds, 0 to not time
+    snapshot_file : str
+        File the snapshots are written to
+    snapshot_rotate : int
+        Number of files the snapshots rotate through
+    snapshot_max_fraction : float
+        Maximum fraction of the wall time spent taking snapshots
+
+    Snapshots are off by default, see online.
+    """
+
+    def __init__(self,name,class_name) :
+        super().__init__(name,class_name,'DQM')
+
+        self.histogram_buffer_size = 1000
+
+        self.snapshot_events = 0
+        self.snapshot_seconds = 0.
+        self.snapshot_file = '%s_snapshot.root' % name
+        self.snapshot_rotate = 1
+        self.snapshot_max_fraction = 0.01
+
+    def online(self, every_n_events = 0, every_seconds = 0., file_name = None, rotate = 1) :
+        """Turn on the online mode
+
+        The histograms are written to file_name every N events and/or
+        every T seconds while the job runs.
+
+        Examples
+        --------
+            from LDMX.DQM import dqm
+            p.sequence.append( dqm.HCalDQM().online(every_seconds = 60.) )
+        """
+        self.snapshot_events = every_n_events
+        self.snapshot_seconds = float(every_seconds)
+        if file_name is not None :
+            self.snapshot_file = file_name
+        self.snapshot_rotate = rotate
+        return self
+
+class EcalDigiVerify(DQMAnalyzer) :
     """Configured EcalDigiVerifier python object
     
     Contains an instance of EcalDigiVerifier that
@@ -29,7 +79,7 @@ class EcalDigiVerify(ldmxcfg.Analyzer) :
     """
 
     def __init__(self,name="EcalDigiVerify") :
-        super().__init__(name,'ldmx::EcalDigiVerifier','DQM')
+        super().__init__(name,'ldmx::EcalDigiVerifier')
 
         self.ecalSimHitColl = "EcalSimHits"
         self.ecalSimHitPass = "" #use whatever pass is available
@@ -48,7 +98,7 @@ class EcalDigiVerify(ldmxcfg.Analyzer) :
                 "Reconstructed [MeV]" , 1000 , 0. , 50. )
 
 
-class HCalDQM(ldmxcfg.Analyzer) :
+class HCalDQM(DQMAnalyzer) :
     """Configured HCalDQM python object
     
     Contains an instance of HCalDQM that
@@ -63,11 +113,17 @@ class HCalDQM(ldmxcfg.Analyzer) :
     """
 
     def __init__(self,name="HCal") :
-        super().__init__(name,'ldmx::HCalDQM','DQM')
+        super().__init__(name,'ldmx::HCalDQM')
+
+        # write a flat 'summary' tree with one entry per event next to the
+        # histograms, so they can be rebuilt offline with any binning
+        self.write_ntuple = False
+        # size of the summary tree branch buffers in bytes, 0 for the ROOT default
+        self.ntuple_basket_size = 0
 
         self.ecal_veto_collection = "EcalVeto"
         
-        titles = ['', '_track_veto', '_bdt', '_self_veto', '_track_bdt', '_vetoes']
+        titles = ['', '_track_veto', '_bdt', '_self_veto', '_track_bdt', '_vetoes', '_hcal_veto']
         for t in titles: 
             self.build1DHistogram("max_pe%s" % t, "Max Photoelectrons in an HCal Module", 1500, 0, 1500)
             self.build1DHistogram("total_pe%s" % t, "Total Photoelectrons", 3000, 0, 3000)
@@ -95,7 +151,7 @@ class HCalDQM(ldmxcfg.Analyzer) :
                            "Photoelectrons in an HCal Module", 1500, 0, 1500, 
                            "Earliest time of HCal hit above threshold (ns)", 1600, -100, 1500)
          
-class PhotoNuclearDQM(ldmxcfg.Analyzer) :
+class PhotoNuclearDQM(DQMAnalyzer) :
     """Configured PhotoNuclearDQM python object
     
     Contains an instance of PhotoNuclearDQM that
@@ -110,7 +166,9 @@ class PhotoNuclearDQM(ldmxcfg.Analyzer) :
     """
 
     def __init__(self,name='PN') :
-        super().__init__(name,'ldmx::PhotoNuclearDQM','DQM')
+        super().__init__(name,'ldmx::PhotoNuclearDQM')
+        self.write_ntuple = False
+        self.ntuple_basket_size = 0
 
         self.build1DHistogram("event_type"         , "", 24, -1, 23)
         self.build1DHistogram("event_type_500mev"  , "", 24, -1, 23)
@@ -182,7 +240,7 @@ class PhotoNuclearDQM(ldmxcfg.Analyzer) :
                            "Recoil electron vertex y (mm)", 
                            320, -80, 80)
 
-class RecoilTrackerDQM(ldmxcfg.Analyzer) :
+class RecoilTrackerDQM(DQMAnalyzer) :
     """Configured RecoilTrackerDQM python object
     
     Contains an instance of RecoilTrackerDQM that
@@ -197,7 +255,9 @@ class RecoilTrackerDQM(ldmxcfg.Analyzer) :
     """
 
     def __init__(self,name='RecoilTracker') :
-        super().__init__(name, "ldmx::RecoilTrackerDQM",'DQM')
+        super().__init__(name, "ldmx::RecoilTrackerDQM")
+        self.write_ntuple = False
+        self.ntuple_basket_size = 0
         
         self.build1DHistogram("track_count", "Track Multiplicity", 10, 0, 10)
         self.build1DHistogram("loose_track_count", "Track Multiplicity", 10, 0, 10)
@@ -215,7 +275,7 @@ class RecoilTrackerDQM(ldmxcfg.Analyzer) :
             self.build1DHistogram("tpy%s" % t, "Recoil e^{-} Truth p_{y} (MeV)", 100, -10, 10)
             self.build1DHistogram("tpz%s" % t, "Recoil e^{-} Truth p_{z} (MeV)", 260, -100, 2500)
 
-class TrigScintSimDQM(ldmxcfg.Analyzer) :
+class TrigScintSimDQM(DQMAnalyzer) :
     """Configured TrigScintSimDQM python object
     
     Contains an instance of TrigScintSimDQM that
@@ -230,12 +290,12 @@ class TrigScintSimDQM(ldmxcfg.Analyzer) :
     """
 
     def __init__(self,name='TrigScintSimUp',hit_coll='TriggerPadUpSimHits',pad='up') :
-        super().__init__(name,'ldmx::TrigScintDQM','DQM')
+        super().__init__(name,'ldmx::TrigScintDQM')
 
         self.hit_collection = hit_coll
         self.pad = pad
 
-class TrigScintDigiDQM(ldmxcfg.Analyzer) :
+class TrigScintDigiDQM(DQMAnalyzer) :
     """Configured TrigScintDigiDQM python object
     
     Contains an instance of TrigScintDigiDQM that
@@ -250,7 +310,7 @@ class TrigScintDigiDQM(ldmxcfg.Analyzer) :
     """
 
     def __init__(self,name='TrigScintDigiUp',hit_coll='trigScintDigisUp',pad='up') :
-        super().__init__(name,'ldmx::TrigScintHitDQM','DQM')
+        super().__init__(name,'ldmx::TrigScintHitDQM')
 
         self.hit_collection = hit_coll
         self.pad = pad
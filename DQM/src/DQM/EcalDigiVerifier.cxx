@@ -1,6 +1,8 @@
 
 #include "DQM/EcalDigiVerifier.h"
 
+#include <algorithm>
+
 namespace ldmx {
 
     void EcalDigiVerifier::configure(Parameters& ps) {
@@ -10,58 +12,84 @@ namespace ldmx {
         ecalRecHitColl_ = ps.getParameter<std::string>( "ecalRecHitColl" );
         ecalRecHitPass_ = ps.getParameter<std::string>( "ecalRecHitPass" );
 
+        buffers_.setBufferSize( ps.getParameter<int>( "histogram_buffer_size" ) );
+        snapshots_.configure(ps, getName());
+
+        return;
+    }
+
+    void EcalDigiVerifier::onProcessStart() {
+
+        numSimHitsPerCell_   = Hist1D( histograms_ , "num_sim_hits_per_cell"   , buffers_ );
+        simEdepRecAmplitude_ = Hist2D( histograms_ , "sim_edep__rec_amplitude" , buffers_ );
+        totalRecEnergy_      = Hist1D( histograms_ , "total_rec_energy"        , buffers_ );
+
+        snapshots_.start(getHistoDirectory(), buffers_);
+
+        return;
+    }
+
+    void EcalDigiVerifier::onProcessEnd() {
+
+        buffers_.flush();
+        snapshots_.finish();
+
         return;
     }
 
     void EcalDigiVerifier::analyze(const ldmx::Event& event) {
 
-        //get truth information sorted into an ID based map
-        std::vector<SimCalorimeterHit> ecalSimHits = event.getCollection<SimCalorimeterHit>( ecalSimHitColl_ , ecalSimHitPass_ );
+        // Count the event and snapshot the histograms if one is due
+        snapshots_.update();
+
+        const std::vector<SimCalorimeterHit> &ecalSimHits = event.getCollection<SimCalorimeterHit>( ecalSimHitColl_ , ecalSimHitPass_ );
+        const std::vector<EcalHit> &ecalRecHits = event.getCollection<EcalHit>( ecalRecHitColl_ , ecalRecHitPass_ );
 
-        //sort sim hits by ID
-        std::sort( ecalSimHits.begin() , ecalSimHits.end() , 
-                []( const SimCalorimeterHit &lhs , const SimCalorimeterHit &rhs ) {
-                    return lhs.getID() < rhs.getID();
+        //sort pointers to the hits by ID instead of copying the collections
+        simHitsByID_.clear();
+        for ( const SimCalorimeterHit &simHit : ecalSimHits ) simHitsByID_.push_back( &simHit );
+        std::sort( simHitsByID_.begin() , simHitsByID_.end() , 
+                []( const SimCalorimeterHit *lhs , const SimCalorimeterHit *rhs ) {
+                    return lhs->getID() < rhs->getID();
                 }
                 );
 
-        std::vector<EcalHit> ecalRecHits = event.getCollection<EcalHit>( ecalRecHitColl_ , ecalRecHitPass_ );
-
-        //sort rec hits by ID
-        std::sort( ecalRecHits.begin() , ecalRecHits.end() , 
-                []( const EcalHit &lhs , const EcalHit &rhs ) {
-                    return lhs.getID() < rhs.getID();
+        recHitsByID_.clear();
+        for ( const EcalHit &recHit : ecalRecHits ) {
+            //skip anything that digi flagged as noise
+            if ( not recHit.isNoise() ) recHitsByID_.push_back( &recHit );
+        }
+        std::sort( recHitsByID_.begin() , recHitsByID_.end() , 
+                []( const EcalHit *lhs , const EcalHit *rhs ) {
+                    return lhs->getID() < rhs->getID();
                 }
                 );
 
+        //merge the two sorted lists, each sim hit is visited at most once
         double totalRecEnergy = 0.;
-        for ( const EcalHit &recHit : ecalRecHits ) {
+        auto simHit = simHitsByID_.begin();
+        for ( const EcalHit *recHit : recHitsByID_ ) {
 
-            //skip anything that digi flagged as noise
-            if ( recHit.isNoise() ) continue;
+            int rawID = recHit->getID();
 
-            int rawID = recHit.getID();
+            //skip sim hits in cells without a rec hit
+            while ( simHit != simHitsByID_.end() and (*simHit)->getID() < rawID ) ++simHit;
 
             //get information for this hit
             int numSimHits = 0;
             double totalSimEDep = 0.;
-            for ( const SimCalorimeterHit &simHit : ecalSimHits ) {
-                if ( rawID == simHit.getID() ) {
-                    numSimHits += simHit.getNumberOfContribs();
-                    totalSimEDep += simHit.getEdep();
-                } else if ( rawID < simHit.getID() ) {
-                    //later sim hits - all done
-                    break;
-                }
+            for ( auto match = simHit; match != simHitsByID_.end() and (*match)->getID() == rawID; ++match ) {
+                numSimHits += (*match)->getNumberOfContribs();
+                totalSimEDep += (*match)->getEdep();
             }
 
-            histograms_.fill( "num_sim_hits_per_cell"   , numSimHits );
-            histograms_.fill( "sim_edep__rec_amplitude" , totalSimEDep , recHit.getAmplitude() );
+            numSimHitsPerCell_.fill( numSimHits );
+            simEdepRecAmplitude_.fill( totalSimEDep , recHit->getAmplitude() );
 
-            totalRecEnergy += recHit.getEnergy();
+            totalRecEnergy += recHit->getEnergy();
         }
 
-        histograms_.fill( "total_rec_energy" , totalRecEnergy );
+        totalRecEnergy_.fill( totalRecEnergy );
 
         if ( totalRecEnergy > 6000. ) {
             setStorageHint( hint_shouldKeep );
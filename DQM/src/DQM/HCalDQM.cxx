@@ -7,10 +7,53 @@ namespace ldmx {
         Analyzer(name, process) { }
 
     void HCalDQM::configure(Parameters& parameters) {
+        buffers_.setBufferSize(parameters.getParameter<int>("histogram_buffer_size"));
+        snapshots_.configure(parameters, getName());
+        ntuple_.setEnabled(parameters.getParameter<bool>("write_ntuple"), 
+                parameters.getParameter<int>("ntuple_basket_size"));
+    }
+
+    void HCalDQM::onProcessStart() {
+
+        nHits_                   = Hist1D(histograms_, "n_hits", buffers_);
+        pe_                      = Hist1D(histograms_, "pe", buffers_);
+        hitTime_                 = Hist1D(histograms_, "hit_time", buffers_);
+        totalPE_                 = Hist1D(histograms_, "total_pe", buffers_);
+        minTimeHitAboveThresh_   = Hist1D(histograms_, "min_time_hit_above_thresh", buffers_);
+        minTimeHitAboveThreshPE_ = Hist2D(histograms_, "min_time_hit_above_thresh:pe", buffers_);
+
+        maxPE_        = Hist1D(histograms_, "max_pe", buffers_);
+        hitTimeMaxPE_ = Hist1D(histograms_, "hit_time_max_pe", buffers_);
+        maxPETime_    = Hist2D(histograms_, "max_pe:time", buffers_);
+        veto_         = Hist1D(histograms_, "veto", buffers_);
+
+        maxPEHcalVeto_        = Hist1D(histograms_, "max_pe_hcal_veto", buffers_);
+        hitTimeMaxPEHcalVeto_ = Hist1D(histograms_, "hit_time_max_pe_hcal_veto", buffers_);
+        maxPETimeHcalVeto_    = Hist2D(histograms_, "max_pe:time_hcal_veto", buffers_);
+        totalPEHcalVeto_      = Hist1D(histograms_, "total_pe_hcal_veto", buffers_);
+        nHitsHcalVeto_        = Hist1D(histograms_, "n_hits_hcal_veto", buffers_);
+
+        ntuple_.book(getHistoDirectory(), "summary", "HCal DQM event summary");
+        ntuple_.branch("n_hits", summary_.nHits);
+        ntuple_.branch("total_pe", summary_.totalPE);
+        ntuple_.branch("min_time_hit_above_thresh", summary_.minTimeHitAboveThresh);
+        ntuple_.branch("max_pe", summary_.maxPE);
+        ntuple_.branch("hit_time_max_pe", summary_.maxPETime);
+        ntuple_.branch("passes_hcal_veto", summary_.passesVeto);
+
+        snapshots_.start(getHistoDirectory(), buffers_);
+    }
+
+    void HCalDQM::onProcessEnd() {
+        buffers_.flush();
+        snapshots_.finish();
     }
 
     void HCalDQM::analyze(const Event & event) { 
 
+        // Count the event and snapshot the histograms if one is due
+        snapshots_.update();
+
         // Check if the collection of digitized HCal hits exist. If it doesn't 
         // don't continue processing.
         if (!event.exists("hcalDigis")) return; 
@@ -20,7 +63,7 @@ namespace ldmx {
      
         // Get the total hit count
         int hitCount = hcalHits.size();  
-        histograms_.fill("n_hits",hitCount); 
+        nHits_.fill(hitCount); 
 
         double totalPE{0};  
 
@@ -29,15 +72,15 @@ namespace ldmx {
         std::vector<const HcalHit *> filteredHits;
         for (const HcalHit &hit : hcalHits ) {
 
-            histograms_.fill("pe",hit.getPE());
-            histograms_.fill("hit_time",hit.getTime());
+            pe_.fill(hit.getPE());
+            hitTime_.fill(hit.getTime());
            
             totalPE += hit.getPE();
 
             if ( hit.getTime() > -999. ) { filteredHits.push_back( &hit ); }
         }
         
-        histograms_.fill("total_pe",totalPE); 
+        totalPE_.fill(totalPE); 
 
         // Sort the array by hit time
         std::sort (filteredHits.begin(), filteredHits.end(), [ ](const auto& lhs, const auto& rhs) 
@@ -55,8 +98,8 @@ namespace ldmx {
             break;
         } 
 
-        histograms_.fill("min_time_hit_above_thresh",minTime); 
-        histograms_.fill("min_time_hit_above_thresh:pe",minTimePE, minTime);  
+        minTimeHitAboveThresh_.fill(minTime); 
+        minTimeHitAboveThreshPE_.fill(minTimePE, minTime);  
 
         float maxPE{-1};
         float maxPETime{-1};
@@ -73,20 +116,30 @@ namespace ldmx {
             maxPE = maxPEHit.getPE();
             maxPETime = maxPEHit.getTime();
             
-            histograms_.fill("max_pe",maxPE);
-            histograms_.fill("hit_time_max_pe",maxPETime); 
-            histograms_.fill("max_pe:time",maxPE, maxPETime);
-            histograms_.fill("veto",hcalVeto.passesVeto());   
+            maxPE_.fill(maxPE);
+            hitTimeMaxPE_.fill(maxPETime); 
+            maxPETime_.fill(maxPE, maxPETime);
+            veto_.fill(hcalVeto.passesVeto());   
 
             if (hcalVeto.passesVeto()) {
-                histograms_.fill("max_pe_hcal_veto",maxPE);
-                histograms_.fill("hit_time_max_pe_hcal_veto",maxPETime); 
-                histograms_.fill("max_pe:time_hcal_veto",maxPE, maxPETime);
-                histograms_.fill("total_pe_hcal_veto",totalPE); 
-                histograms_.fill("n_hits_hcal_veto",hitCount); 
+                maxPEHcalVeto_.fill(maxPE);
+                hitTimeMaxPEHcalVeto_.fill(maxPETime); 
+                maxPETimeHcalVeto_.fill(maxPE, maxPETime);
+                totalPEHcalVeto_.fill(totalPE); 
+                nHitsHcalVeto_.fill(hitCount); 
                 passesHcalVeto = true;
             }
         }
+
+        if (ntuple_.enabled()) {
+            summary_.nHits = hitCount;
+            summary_.totalPE = totalPE;
+            summary_.minTimeHitAboveThresh = minTime;
+            summary_.maxPE = maxPE;
+            summary_.maxPETime = maxPETime;
+            summary_.passesVeto = passesHcalVeto;
+            ntuple_.fill();
+        }
     }
 
 } // ldmx
@@ -0,0 +1,119 @@
+
+#include "DQM/HistogramSnapshots.h"
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+//----------//
+//   ROOT   //
+//----------//
+#include "TFile.h"
+#include "TH1.h"
+#include "TList.h"
+
+namespace ldmx {
+
+    void HistogramSnapshots::configure(Parameters& parameters, const std::string& name) {
+        name_ = name;
+        everyEvents_ = parameters.getParameter<int>("snapshot_events");
+        everySeconds_ = std::chrono::duration<double>(parameters.getParameter<double>("snapshot_seconds"));
+        enabled_ = everyEvents_ > 0 or everySeconds_.count() > 0;
+        if (!enabled_) return;
+
+        file_ = parameters.getParameter<std::string>("snapshot_file");
+        if (file_.size() > 5 and file_.compare(file_.size() - 5, 5, ".root") == 0) {
+            file_.erase(file_.size() - 5);
+        }
+        if (file_.empty()) {
+            EXCEPTION_RAISE("HistogramSnapshots", "No snapshot file given for " + name_ + ".");
+        }
+
+        nFiles_ = parameters.getParameter<int>("snapshot_rotate");
+        if (nFiles_ < 1) nFiles_ = 1;
+
+        maxFraction_ = parameters.getParameter<double>("snapshot_max_fraction");
+        if (maxFraction_ <= 0. or maxFraction_ > 1.) {
+            EXCEPTION_RAISE("HistogramSnapshots", "The snapshot_max_fraction of " + name_
+                    + " must be in (0,1], not " + std::to_string(maxFraction_) + ".");
+        }
+    }
+
+    void HistogramSnapshots::start(TDirectory* dir, HistogramBuffers& buffers) {
+        dir_ = dir;
+        buffers_ = &buffers;
+        last_ = Clock::now();
+        notBefore_ = last_;
+    }
+
+    void HistogramSnapshots::checkThread() {
+        if (thread_ == std::thread::id()) {
+            thread_ = std::this_thread::get_id();
+            return;
+        }
+        EXCEPTION_RAISE("HistogramSnapshots", "Histogram snapshots of " + name_
+                + " are only supported when all events are analyzed on the same thread.");
+    }
+
+    void HistogramSnapshots::snapshot() {
+
+        auto begin{Clock::now()};
+        if (begin < notBefore_) return;
+
+        // Fill the buffered values so the snapshot is up to date, safe since
+        // update checked that no other thread analyzes (and so fills)
+        buffers_->flush();
+
+        std::string path{file_};
+        if (nFiles_ > 1) path += "_" + std::to_string(nSnapshots_ % nFiles_);
+        path += ".root";
+        std::string tmpPath{path + ".tmp"};
+
+        {
+            // Don't leave the current directory pointing at the snapshot file
+            TDirectory::TContext context;
+
+            // Fast compression, the snapshot is overwritten soon anyway
+            TFile file(tmpPath.c_str(), "RECREATE", "", 1);
+            if (file.IsZombie()) {
+                EXCEPTION_RAISE("HistogramSnapshots", "Unable to open the snapshot file '"
+                        + tmpPath + "' of " + name_ + ".");
+            }
+
+            TIter next(dir_->GetList());
+            while (TObject* obj = next()) {
+                if (obj->InheritsFrom(TH1::Class())) file.WriteTObject(obj);
+            }
+            file.Close();
+        }
+
+        if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+            EXCEPTION_RAISE("HistogramSnapshots", "Unable to move the snapshot of " + name_
+                    + " to '" + path + "'.");
+        }
+
+        auto end{Clock::now()};
+        std::chrono::duration<double> cost{end - begin};
+        totalTime_ += cost;
+        maxTime_ = std::max(maxTime_, cost);
+        ++nSnapshots_;
+
+        lastEvents_ = nEvents_;
+        last_ = end;
+        notBefore_ = end + std::chrono::duration_cast<Clock::duration>(cost*(1./maxFraction_ - 1.));
+    }
+
+    void HistogramSnapshots::finish() {
+        if (!enabled_) return;
+        std::cout << "[ " << name_ << " ]: " << nSnapshots_ << " histogram snapshots";
+        if (nSnapshots_ > 0) {
+            std::cout << ", " << 1000.*totalTime_.count()/nSnapshots_ << " ms on average, "
+                << 1000.*maxTime_.count() << " ms at most";
+        }
+        std::cout << std::endl;
+    }
+
+} // ldmx
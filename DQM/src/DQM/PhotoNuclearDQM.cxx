@@ -17,7 +17,7 @@
 //   LDMX   //
 //----------//
 #include "Framework/Event.h"
-#include "Tools/AnalysisUtils.h"
+#include "Tools/ParticleGraph.h"
 
 namespace ldmx { 
 
@@ -27,7 +27,49 @@ namespace ldmx {
     PhotoNuclearDQM::~PhotoNuclearDQM() {}
 
     void PhotoNuclearDQM::onProcessStart() {
-      
+
+        recoilVertexX_             = Hist1D(histograms_, "recoil_vertex_x", buffers_);
+        recoilVertexY_             = Hist1D(histograms_, "recoil_vertex_y", buffers_);
+        recoilVertexZ_             = Hist1D(histograms_, "recoil_vertex_z", buffers_);
+        recoilVertexXY_            = Hist2D(histograms_, "recoil_vertex_x:recoil_vertex_y", buffers_);
+        pnParticleMult_            = Hist1D(histograms_, "pn_particle_mult", buffers_);
+        pnGammaEnergy_             = Hist1D(histograms_, "pn_gamma_energy", buffers_);
+        pnGammaIntZ_               = Hist1D(histograms_, "pn_gamma_int_z", buffers_);
+        pnGammaVertexX_            = Hist1D(histograms_, "pn_gamma_vertex_x", buffers_);
+        pnGammaVertexY_            = Hist1D(histograms_, "pn_gamma_vertex_y", buffers_);
+        pnGammaVertexZ_            = Hist1D(histograms_, "pn_gamma_vertex_z", buffers_);
+        hardestKE_                 = Hist1D(histograms_, "hardest_ke", buffers_);
+        hardestTheta_              = Hist1D(histograms_, "hardest_theta", buffers_);
+        hardestKETheta_            = Hist2D(histograms_, "h_ke_h_theta", buffers_);
+        hardestProtonKE_           = Hist1D(histograms_, "hardest_p_ke", buffers_);
+        hardestProtonTheta_        = Hist1D(histograms_, "hardest_p_theta", buffers_);
+        hardestNeutronKE_          = Hist1D(histograms_, "hardest_n_ke", buffers_);
+        hardestNeutronTheta_       = Hist1D(histograms_, "hardest_n_theta", buffers_);
+        hardestPionKE_             = Hist1D(histograms_, "hardest_pi_ke", buffers_);
+        hardestPionTheta_          = Hist1D(histograms_, "hardest_pi_theta", buffers_);
+        eventType_                 = Hist1D(histograms_, "event_type", buffers_);
+        eventType500MeV_           = Hist1D(histograms_, "event_type_500mev", buffers_);
+        eventType2000MeV_          = Hist1D(histograms_, "event_type_2000mev", buffers_);
+        eventTypeCompact_          = Hist1D(histograms_, "event_type_compact", buffers_);
+        eventTypeCompact500MeV_    = Hist1D(histograms_, "event_type_compact_500mev", buffers_);
+        eventTypeCompact2000MeV_   = Hist1D(histograms_, "event_type_compact_2000mev", buffers_);
+        neutronKE2ndHardestKE_     = Hist2D(histograms_, "1n_ke:2nd_h_ke", buffers_);
+        neutronEnergy_             = Hist1D(histograms_, "1n_neutron_energy", buffers_);
+        neutronEnergyDiff_         = Hist1D(histograms_, "1n_energy_diff", buffers_);
+        neutronEnergyFrac_         = Hist1D(histograms_, "1n_energy_frac", buffers_);
+        dineutronN2Energy_         = Hist1D(histograms_, "2n_n2_energy", buffers_);
+        dineutronEnergyFrac_       = Hist1D(histograms_, "2n_energy_frac", buffers_);
+        dineutronEnergyOther_      = Hist1D(histograms_, "2n_energy_other", buffers_);
+        chargedKaonKE2ndHardestKE_ = Hist2D(histograms_, "1kp_ke:2nd_h_ke", buffers_);
+        chargedKaonEnergy_         = Hist1D(histograms_, "1kp_energy", buffers_);
+        chargedKaonEnergyDiff_     = Hist1D(histograms_, "1kp_energy_diff", buffers_);
+        chargedKaonEnergyFrac_     = Hist1D(histograms_, "1kp_energy_frac", buffers_);
+        neutralKaonKE2ndHardestKE_ = Hist2D(histograms_, "1k0_ke:2nd_h_ke", buffers_);
+        neutralKaonEnergy_         = Hist1D(histograms_, "1k0_energy", buffers_);
+        neutralKaonEnergyDiff_     = Hist1D(histograms_, "1k0_energy_diff", buffers_);
+        neutralKaonEnergyFrac_     = Hist1D(histograms_, "1k0_energy_frac", buffers_);
+        neutronEventType_          = Hist1D(histograms_, "1n_event_type", buffers_);
+
         std::vector<std::string> labels = {"", 
             "Nothing hard", // 0  
             "1 n", // 1
@@ -54,9 +96,9 @@ namespace ldmx {
         };
 
         std::vector<TH1*> hists = { 
-            histograms_.get("event_type"),
-            histograms_.get("event_type_500mev"),
-            histograms_.get("event_type_2000mev"),
+            eventType_.get(),
+            eventType500MeV_.get(),
+            eventType2000MeV_.get(),
 
         };
 
@@ -78,9 +120,9 @@ namespace ldmx {
         };
 
         hists = {
-            histograms_.get("event_type_compact"),
-            histograms_.get("event_type_compact_500mev"),
-            histograms_.get("event_type_compact_2000mev"),
+            eventTypeCompact_.get(),
+            eventTypeCompact500MeV_.get(),
+            eventTypeCompact2000MeV_.get(),
         };
 
         for (int ilabel{1}; ilabel < labels.size(); ++ilabel) { 
@@ -97,62 +139,98 @@ namespace ldmx {
             ""
         };
 
-        TH1* hist = histograms_.get("1n_event_type"); 
+        TH1* hist = neutronEventType_.get(); 
         for (int ilabel{1}; ilabel < n_labels.size(); ++ilabel) { 
             hist->GetXaxis()->SetBinLabel(ilabel, n_labels[ilabel-1].c_str());
         }
 
+        ntuple_.book(getHistoDirectory(), "summary", "Photo-nuclear DQM event summary");
+        ntuple_.branch("recoil_vertex_x", summary_.recoilVertexX);
+        ntuple_.branch("recoil_vertex_y", summary_.recoilVertexY);
+        ntuple_.branch("recoil_vertex_z", summary_.recoilVertexZ);
+        ntuple_.branch("pn_particle_mult", summary_.pnParticleMult);
+        ntuple_.branch("pn_gamma_energy", summary_.pnGammaEnergy);
+        ntuple_.branch("pn_gamma_int_z", summary_.pnGammaIntZ);
+        ntuple_.branch("hardest_ke", summary_.hardestKE);
+        ntuple_.branch("hardest_theta", summary_.hardestTheta);
+        ntuple_.branch("hardest_p_ke", summary_.hardestProtonKE);
+        ntuple_.branch("hardest_n_ke", summary_.hardestNeutronKE);
+        ntuple_.branch("hardest_pi_ke", summary_.hardestPionKE);
+        ntuple_.branch("event_type", summary_.eventType);
+        ntuple_.branch("event_type_500mev", summary_.eventType500MeV);
+        ntuple_.branch("event_type_2000mev", summary_.eventType2000MeV);
+        ntuple_.branch("event_type_compact", summary_.eventTypeCompact);
+        ntuple_.branch("event_type_compact_500mev", summary_.eventTypeCompact500MeV);
+        ntuple_.branch("event_type_compact_2000mev", summary_.eventTypeCompact2000MeV);
+
+        snapshots_.start(getHistoDirectory(), buffers_);
+    }
+
+    void PhotoNuclearDQM::onProcessEnd() {
+        buffers_.flush();
+        snapshots_.finish();
     }
 
-    void PhotoNuclearDQM::configure(Parameters& parameters) { }
+    void PhotoNuclearDQM::configure(Parameters& parameters) {
+        buffers_.setBufferSize(parameters.getParameter<int>("histogram_buffer_size"));
+        snapshots_.configure(parameters, getName());
+        ntuple_.setEnabled(parameters.getParameter<bool>("write_ntuple"), 
+                parameters.getParameter<int>("ntuple_basket_size"));
+    }
 
     void PhotoNuclearDQM::analyze(const Event& event) {
 
-        // Get the particle map from the event.  If the particle map is empty,
-        // don't process the event.
-        auto particleMap{event.getMap<int,SimParticle>("SimParticles")};
-        if (particleMap.size() == 0) return; 
+        // Count the event and snapshot the histograms if one is due
+        snapshots_.update();
 
-        // Get the recoil electron
-        auto [ trackID, recoil ] = Analysis::getRecoil(particleMap);
+        // Build the particle graph of the event.  If the particle map is
+        // empty, don't process the event.
+        const auto &particleMap{event.getMap<int, SimParticle>("SimParticles")};
+        ParticleGraph graph{particleMap};
+        if (graph.size() == 0) return; 
 
-        histograms_.fill("recoil_vertex_x",recoil->getVertex()[0]); 
-        histograms_.fill("recoil_vertex_y",recoil->getVertex()[1]); 
-        histograms_.fill("recoil_vertex_z",recoil->getVertex()[2]);
-        histograms_.fill("recoil_vertex_x:recoil_vertex_y", 
-                         recoil->getVertex()[0], 
+        // Get the recoil electron
+        auto recoilIndex{graph.recoil()};
+        if (recoilIndex == ParticleGraph::NOT_FOUND) return; 
+        const SimParticle* recoil{&graph.particle(recoilIndex)};
+
+        recoilVertexX_.fill(recoil->getVertex()[0]); 
+        recoilVertexY_.fill(recoil->getVertex()[1]); 
+        recoilVertexZ_.fill(recoil->getVertex()[2]);
+        recoilVertexXY_.fill(recoil->getVertex()[0], 
                          recoil->getVertex()[1]);  
 
         // Use the recoil electron to retrieve the gamma that underwent a 
         // photo-nuclear reaction.
-        auto pnGamma{Analysis::getPNGamma(particleMap, recoil, 2500.)};
-        if (pnGamma == nullptr) { 
+        auto pnIndex{graph.pnGamma(recoilIndex, 2500.)};
+        if (pnIndex == ParticleGraph::NOT_FOUND) { 
             std::cout << "[ PhotoNuclearDQM ]: PN Daughter is lost, skipping." << std::endl;
             return;
         }
+        const SimParticle* pnGamma{&graph.particle(pnIndex)};
 
-        histograms_.fill("pn_particle_mult",pnGamma->getDaughters().size());
-        histograms_.fill("pn_gamma_energy",pnGamma->getEnergy()); 
-        histograms_.fill("pn_gamma_int_z",pnGamma->getEndPoint()[2]); 
-        histograms_.fill("pn_gamma_vertex_x",pnGamma->getVertex()[0]);  
-        histograms_.fill("pn_gamma_vertex_y",pnGamma->getVertex()[1]);  
-        histograms_.fill("pn_gamma_vertex_z",pnGamma->getVertex()[2]);  
+        pnParticleMult_.fill(pnGamma->getDaughters().size());
+        pnGammaEnergy_.fill(pnGamma->getEnergy()); 
+        pnGammaIntZ_.fill(pnGamma->getEndPoint()[2]); 
+        pnGammaVertexX_.fill(pnGamma->getVertex()[0]);  
+        pnGammaVertexY_.fill(pnGamma->getVertex()[1]);  
+        pnGammaVertexZ_.fill(pnGamma->getVertex()[2]);  
 
         double lke{-1},   lt{-1}; 
         double lpke{-1},  lpt{-1};
         double lnke{-1},  lnt{-1};
         double lpike{-1}, lpit{-1};
-        
-        std::vector<const SimParticle*> pnDaughters; 
-
-        // Loop through all of the PN daughters and extract kinematic 
-        // information.
-        for (const auto& daughterTrackID : pnGamma->getDaughters() ) {
 
-            //skip daughters that weren't saved
-            if ( particleMap.count( daughterTrackID ) == 0 ) continue; 
+        // Counts for the compact classification that don't depend on the threshold
+        CompactCounts compact; 
+        double hardEnergy{0.8*pnGamma->getEnergy()}; 
+        
+        // Loop through all of the saved PN daughters and extract kinematic 
+        // information once.
+        pnDaughters_.clear(); 
+        for (auto daughterIndex : graph.daughters(pnIndex)) {
 
-            auto daughter{&(particleMap.at(daughterTrackID))};
+            const SimParticle* daughter{&graph.particle(daughterIndex)};
 
             // Get the PDG ID
             auto pdgID{daughter->getPdgID()};
@@ -179,118 +257,144 @@ namespace ldmx {
                 lpike = ke; 
                 lpit = theta; 
             }
+
+            int absPdgID{abs(pdgID)}; 
+            if (ke < 500) { 
+                compact.soft++;
+            } else if (ke >= hardEnergy) {
+                if (absPdgID == 2112) compact.n++;
+                else if (absPdgID == 130) compact.k0l++; 
+                else if (absPdgID == 321) compact.kp++; 
+                else if (absPdgID == 310) compact.k0s++;
+            }
             
-            pnDaughters.push_back(daughter); 
+            pnDaughters_.push_back({daughter, ke, theta, absPdgID}); 
+        }
+
+        hardestKE_.fill(lke); 
+        hardestTheta_.fill(lt);
+        hardestKETheta_.fill(lke, lt); 
+        hardestProtonKE_.fill(lpke); 
+        hardestProtonTheta_.fill(lpt); 
+        hardestNeutronKE_.fill(lnke); 
+        hardestNeutronTheta_.fill(lnt); 
+        hardestPionKE_.fill(lpike); 
+        hardestPionTheta_.fill(lpit); 
+
+        // Sort the daughters by kinetic energy once, the daughters above 
+        // each threshold are then the front of the list.
+        std::sort (pnDaughters_.begin(), pnDaughters_.end(), [] (const auto& lhs, const auto& rhs) 
+        {
+            return lhs.ke > rhs.ke; 
+        }); 
+
+        // Classify the event at each threshold, going from the highest to the 
+        // lowest so the multiplicities only need to be extended.
+        const double thresholds[] = {2000, 500, 200}; 
+        int eventTypes[3], eventTypesComp[3]; 
+        Multiplicities mult; 
+        std::size_t iDaughter{0}; 
+        for (int iThreshold{0}; iThreshold < 3; ++iThreshold) { 
+            for (; iDaughter < pnDaughters_.size() && pnDaughters_[iDaughter].ke > thresholds[iThreshold]; ++iDaughter) {
+                const Daughter &daughter{pnDaughters_[iDaughter]}; 
+                mult.add(daughter); 
+                if ((daughter.pdgID == 2112) && (daughter.ke >= 500) && (daughter.ke < hardEnergy)) compact.n_t++;
+            }
+            eventTypes[iThreshold] = classifyEvent(mult); 
+            eventTypesComp[iThreshold] = classifyCompactEvent(compact, pnDaughters_.size()); 
         }
 
-        histograms_.fill("hardest_ke",lke); 
-        histograms_.fill("hardest_theta",lt);
-        histograms_.fill("h_ke_h_theta",lke, lt); 
-        histograms_.fill("hardest_p_ke",lpke); 
-        histograms_.fill("hardest_p_theta",lpt); 
-        histograms_.fill("hardest_n_ke",lnke); 
-        histograms_.fill("hardest_n_theta",lnt); 
-        histograms_.fill("hardest_pi_ke",lpike); 
-        histograms_.fill("hardest_pi_theta",lpit); 
-
-        // Classify the event
-        auto eventType{classifyEvent(pnDaughters, 200)};
-        auto eventType500MeV{classifyEvent(pnDaughters, 500)};
-        auto eventType2000MeV{classifyEvent(pnDaughters, 2000)};
-
-        auto eventTypeComp{classifyCompactEvent(pnGamma, pnDaughters, 200)}; 
-        auto eventTypeComp500MeV{classifyCompactEvent(pnGamma, pnDaughters, 200)}; 
-        auto eventTypeComp2000MeV{classifyCompactEvent(pnGamma, pnDaughters, 200)}; 
-
-        histograms_.fill("event_type",eventType);
-        histograms_.fill("event_type_500mev",eventType500MeV);
-        histograms_.fill("event_type_2000mev",eventType2000MeV);
-
-        histograms_.fill("event_type_compact",eventTypeComp);
-        histograms_.fill("event_type_compact_500mev",eventTypeComp500MeV);
-        histograms_.fill("event_type_compact_2000mev",eventTypeComp2000MeV);
+        auto eventType{eventTypes[2]};
+
+        eventType_.fill(eventType);
+        eventType500MeV_.fill(eventTypes[1]);
+        eventType2000MeV_.fill(eventTypes[0]);
+
+        eventTypeCompact_.fill(eventTypesComp[2]);
+        eventTypeCompact500MeV_.fill(eventTypesComp[1]);
+        eventTypeCompact2000MeV_.fill(eventTypesComp[0]);
+
+        if (ntuple_.enabled()) {
+            summary_.recoilVertexX = recoil->getVertex()[0];
+            summary_.recoilVertexY = recoil->getVertex()[1];
+            summary_.recoilVertexZ = recoil->getVertex()[2];
+            summary_.pnParticleMult = pnGamma->getDaughters().size();
+            summary_.pnGammaEnergy = pnGamma->getEnergy();
+            summary_.pnGammaIntZ = pnGamma->getEndPoint()[2];
+            summary_.hardestKE = lke;
+            summary_.hardestTheta = lt;
+            summary_.hardestProtonKE = lpke;
+            summary_.hardestNeutronKE = lnke;
+            summary_.hardestPionKE = lpike;
+            summary_.eventType = eventTypes[2];
+            summary_.eventType500MeV = eventTypes[1];
+            summary_.eventType2000MeV = eventTypes[0];
+            summary_.eventTypeCompact = eventTypesComp[2];
+            summary_.eventTypeCompact500MeV = eventTypesComp[1];
+            summary_.eventTypeCompact2000MeV = eventTypesComp[0];
+            ntuple_.fill();
+        }
 
         double slke{-9999};
         double nEnergy{-9999}, energyDiff{-9999}, energyFrac{-9999};
          
         if (eventType == 1 || eventType == 17 || eventType == 16 || eventType == 18 || eventType == 2) {
 
-            std::sort (pnDaughters.begin(), pnDaughters.end(), [] (const auto& lhs, const auto& rhs) 
-            {
-                double lhs_ke = lhs->getEnergy() - lhs->getMass(); 
-                double rhs_ke = rhs->getEnergy() - rhs->getMass(); 
-                return lhs_ke > rhs_ke; 
-            }); 
-           
-
-            nEnergy = pnDaughters[0]->getEnergy() - pnDaughters[0]->getMass(); 
+            nEnergy = pnDaughters_[0].ke; 
             slke = -9999; 
-            if (pnDaughters.size() > 1) slke = pnDaughters[1]->getEnergy() - pnDaughters[1]->getMass();
+            if (pnDaughters_.size() > 1) slke = pnDaughters_[1].ke;
             energyDiff = pnGamma->getEnergy() - nEnergy; 
             energyFrac = nEnergy/pnGamma->getEnergy(); 
 
             if (eventType == 1) { 
-                histograms_.fill("1n_ke:2nd_h_ke",nEnergy, slke);
-                histograms_.fill("1n_neutron_energy",nEnergy);  
-                histograms_.fill("1n_energy_diff",energyDiff);
-                histograms_.fill("1n_energy_frac",energyFrac); 
+                neutronKE2ndHardestKE_.fill(nEnergy, slke);
+                neutronEnergy_.fill(nEnergy);  
+                neutronEnergyDiff_.fill(energyDiff);
+                neutronEnergyFrac_.fill(energyFrac); 
             } else if (eventType == 2) { 
-                histograms_.fill("2n_n2_energy",slke); 
+                dineutronN2Energy_.fill(slke); 
                 auto energyFrac2n = (nEnergy + slke)/pnGamma->getEnergy();
-                histograms_.fill("2n_energy_frac",energyFrac2n);
-                histograms_.fill("2n_energy_other",pnGamma->getEnergy() - energyFrac2n); 
+                dineutronEnergyFrac_.fill(energyFrac2n);
+                dineutronEnergyOther_.fill(pnGamma->getEnergy() - energyFrac2n); 
                   
             } else if (eventType == 17) { 
-                histograms_.fill("1kp_ke:2nd_h_ke",nEnergy, slke);
-                histograms_.fill("1kp_energy",nEnergy);  
-                histograms_.fill("1kp_energy_diff",energyDiff);
-                histograms_.fill("1kp_energy_frac",energyFrac); 
+                chargedKaonKE2ndHardestKE_.fill(nEnergy, slke);
+                chargedKaonEnergy_.fill(nEnergy);  
+                chargedKaonEnergyDiff_.fill(energyDiff);
+                chargedKaonEnergyFrac_.fill(energyFrac); 
             } else if (eventType == 16 || eventType == 18) { 
-                histograms_.fill("1k0_ke:2nd_h_ke",nEnergy, slke);
-                histograms_.fill("1k0_energy",nEnergy);  
-                histograms_.fill("1k0_energy_diff",energyDiff);
-                histograms_.fill("1k0_energy_frac",energyFrac); 
+                neutralKaonKE2ndHardestKE_.fill(nEnergy, slke);
+                neutralKaonEnergy_.fill(nEnergy);  
+                neutralKaonEnergyDiff_.fill(energyDiff);
+                neutralKaonEnergyFrac_.fill(energyFrac); 
             }
 
-            auto nPdgID{abs(pnDaughters[0]->getPdgID())};
+            auto nPdgID{pnDaughters_[0].pdgID};
             auto nEventType{-10}; 
             if (nPdgID == 2112) nEventType = 1; 
             else if (nPdgID == 2212) nEventType = 2; 
             else if (nPdgID == 211) nEventType = 3;
             else if (nPdgID == 111) nEventType = 4; 
        
-            histograms_.fill("1n_event_type",nEventType); 
+            neutronEventType_.fill(nEventType); 
 
         }
     }
 
-    int PhotoNuclearDQM::classifyEvent(const std::vector< const SimParticle*> daughters, double threshold) {
-
-        short n{0}, p{0}, pi{0}, pi0{0}, exotic{0}, k0l{0}, kp{0}, k0s{0}, 
-              lambda{0};
-
-        // Loop through all of the PN daughters and extract kinematic 
-        // information.
-        for (const auto& daughter : daughters ) {
+    void PhotoNuclearDQM::Multiplicities::add(const Daughter& daughter) {
+        if (daughter.pdgID == 2112) n++;
+        else if (daughter.pdgID == 2212) p++;
+        else if (daughter.pdgID == 211) pi++;
+        else if (daughter.pdgID == 111) pi0++;
+        else if (daughter.pdgID == 130) k0l++; 
+        else if (daughter.pdgID == 321) kp++; 
+        else if (daughter.pdgID == 310) k0s++;
+        else exotic++;
+    }
 
-            // Calculate the kinetic energy
-            auto ke{daughter->getEnergy() - daughter->getMass()};
-            
-            // If the kinetic energy is below threshold, continue
-            if (ke <= threshold) continue;
+    int PhotoNuclearDQM::classifyEvent(const Multiplicities &m) {
 
-            // Get the PDG ID
-            auto pdgID{abs(daughter->getPdgID())};
-
-            if (pdgID == 2112) n++;
-            else if (pdgID == 2212) p++;
-            else if (pdgID == 211) pi++;
-            else if (pdgID == 111) pi0++;
-            else if (pdgID == 130) k0l++; 
-            else if (pdgID == 321) kp++; 
-            else if (pdgID == 310) k0s++;
-            else exotic++;
-        }
+        auto [n, p, pi, pi0, exotic, k0l, kp, k0s]{m};
 
         int kaons = k0l + kp + k0s; 
         int nucleons = n + p; 
@@ -362,49 +466,21 @@ namespace ldmx {
         return 20;
     }
 
-    int PhotoNuclearDQM::classifyCompactEvent(const SimParticle* pnGamma, const std::vector< const SimParticle*> daughters, double threshold) {
-   
-        short n{0}, n_t{0}, k0l{0}, kp{0}, k0s{0}, soft{0};
-
-        // Loop through all of the PN daughters and extract kinematic 
-        // information.
-        for (const auto& daughter : daughters ) {
+    int PhotoNuclearDQM::classifyCompactEvent(const CompactCounts &c, std::size_t nDaughters) {
 
-            // Calculate the kinetic energy
-            auto ke{daughter->getEnergy() - daughter->getMass()};
-            
-            // Get the PDG ID
-            auto pdgID{abs(daughter->getPdgID())};
-
-            if (ke < 500) { 
-                soft++;
-                continue; 
-            } 
-            
-            if (ke >= 0.8*pnGamma->getEnergy()) {
-                if (pdgID == 2112) n++;
-                else if (pdgID == 130) k0l++; 
-                else if (pdgID == 321) kp++; 
-                else if (pdgID == 310) k0s++;
-                continue;
-            }
-
-            if ((pdgID == 2112) && ke > threshold) n_t++;
-        }
-
-        int neutral_kaons{k0l + k0s};
+        int neutral_kaons{c.k0l + c.k0s};
         
-        if (n != 0) return 0; 
-        if (kp != 0) return 1; 
+        if (c.n != 0) return 0; 
+        if (c.kp != 0) return 1; 
         if (neutral_kaons != 0) return 2; 
-        if (n_t == 2) return 3; 
-        if (soft == daughters.size()) return 4; 
+        if (c.n_t == 2) return 3; 
+        if (c.soft == nDaughters) return 4; 
 
         return 5; 
     
     }
 
-    void PhotoNuclearDQM::printParticleTree(std::map< int, SimParticle > particleMap) { 
+    void PhotoNuclearDQM::printParticleTree(const std::map< int, SimParticle > &particleMap) { 
     
         std::vector< int > printedParticles; 
 
@@ -425,8 +501,8 @@ namespace ldmx {
         } 
     }
 
-    std::vector< int > PhotoNuclearDQM::printDaughters(std::map< int, SimParticle > particleMap, 
-            const SimParticle particle, int depth) { 
+    std::vector< int > PhotoNuclearDQM::printDaughters(const std::map< int, SimParticle > &particleMap, 
+            const SimParticle &particle, int depth) { 
       
         std::vector< int > printedParticles; 
  
@@ -442,13 +518,15 @@ namespace ldmx {
         
             // Print the ith daughter particle
             std::cout << prefix; 
-            particleMap[daughter].Print();
+            particleMap.at(daughter).Print();
             printedParticles.push_back(daughter); 
 
             // Print the Daughters
-            std::vector< int > printedDaughters = printDaughters(particleMap, particleMap[daughter], depth + 1);
+            std::vector< int > printedDaughters = printDaughters(particleMap, particleMap.at(daughter), depth + 1);
             printedParticles.insert(printedParticles.end(), printedDaughters.begin(), printedDaughters.end()); 
         }
+
+        return printedParticles;
     }
 
 } // ldmx
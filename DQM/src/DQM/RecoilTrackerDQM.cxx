@@ -17,12 +17,45 @@ namespace ldmx {
 
     void RecoilTrackerDQM::onProcessStart() {
 
+        tp_  = Hist1D(histograms_, "tp", buffers_);
+        tpt_ = Hist1D(histograms_, "tpt", buffers_);
+        tpx_ = Hist1D(histograms_, "tpx", buffers_);
+        tpy_ = Hist1D(histograms_, "tpy", buffers_);
+        tpz_ = Hist1D(histograms_, "tpz", buffers_);
+
+        tpTrackVeto_  = Hist1D(histograms_, "tp_track_veto", buffers_);
+        tptTrackVeto_ = Hist1D(histograms_, "tpt_track_veto", buffers_);
+        tpxTrackVeto_ = Hist1D(histograms_, "tpx_track_veto", buffers_);
+        tpyTrackVeto_ = Hist1D(histograms_, "tpy_track_veto", buffers_);
+        tpzTrackVeto_ = Hist1D(histograms_, "tpz_track_veto", buffers_);
+
+        ntuple_.book(getHistoDirectory(), "summary", "Recoil tracker DQM event summary");
+        ntuple_.branch("tp", summary_.p);
+        ntuple_.branch("tpt", summary_.pt);
+        ntuple_.branch("tpx", summary_.px);
+        ntuple_.branch("tpy", summary_.py);
+        ntuple_.branch("tpz", summary_.pz);
+        ntuple_.branch("passes_track_veto", summary_.passesTrackVeto);
+
+        snapshots_.start(getHistoDirectory(), buffers_);
+    }
+
+    void RecoilTrackerDQM::onProcessEnd() {
+        buffers_.flush();
+        snapshots_.finish();
     }
 
     void RecoilTrackerDQM::configure(Parameters& parameters) {
+        buffers_.setBufferSize(parameters.getParameter<int>("histogram_buffer_size"));
+        snapshots_.configure(parameters, getName());
+        ntuple_.setEnabled(parameters.getParameter<bool>("write_ntuple"), 
+                parameters.getParameter<int>("ntuple_basket_size"));
     }
 
     void RecoilTrackerDQM::analyze(const Event & event) { 
+
+        // Count the event and snapshot the histograms if one is due
+        snapshots_.update();
    
         // If the collection of findable tracks doesn't exist, stop processing
         // the event.
@@ -83,11 +116,11 @@ namespace ldmx {
             }
         } 
             
-        histograms_.fill("tp",p);
-        histograms_.fill("tpt",pt); 
-        histograms_.fill("tpx",px); 
-        histograms_.fill("tpy",py); 
-        histograms_.fill("tpz",pz); 
+        tp_.fill(p);
+        tpt_.fill(pt); 
+        tpx_.fill(px); 
+        tpy_.fill(py); 
+        tpz_.fill(pz); 
   
         bool passesTrackVeto{false}; 
         // Check if the TrackerVeto result exists
@@ -103,11 +136,21 @@ namespace ldmx {
         }
 
         if (passesTrackVeto) { 
-            histograms_.fill("tp_track_veto",p);
-            histograms_.fill("tpt_track_veto",pt); 
-            histograms_.fill("tpx_track_veto",px); 
-            histograms_.fill("tpy_track_veto",py); 
-            histograms_.fill("tpz_track_veto",pz); 
+            tpTrackVeto_.fill(p);
+            tptTrackVeto_.fill(pt); 
+            tpxTrackVeto_.fill(px); 
+            tpyTrackVeto_.fill(py); 
+            tpzTrackVeto_.fill(pz); 
+        }
+
+        if (ntuple_.enabled()) {
+            summary_.p = p;
+            summary_.pt = pt;
+            summary_.px = px;
+            summary_.py = py;
+            summary_.pz = pz;
+            summary_.passesTrackVeto = passesTrackVeto;
+            ntuple_.fill();
         }
     }
 
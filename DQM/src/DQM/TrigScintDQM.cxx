@@ -32,11 +32,28 @@ namespace ldmx {
                            "Photoelectrons in a TrigScint bar", 1500, 0, 1500, 
                            "Earliest time of TrigScint hit above threshold (ns)", 1600, -100, 1500);
 
+        nHits_       = Hist1D(histograms_, "n_hits", buffers_);
+        totalEnergy_ = Hist1D(histograms_, "total_energy", buffers_);
+        energy_      = Hist1D(histograms_, "energy", buffers_);
+        hitTime_     = Hist1D(histograms_, "hit_time", buffers_);
+        id_          = Hist1D(histograms_, "id", buffers_);
+        x_           = Hist1D(histograms_, "x", buffers_);
+        y_           = Hist1D(histograms_, "y", buffers_);
+        z_           = Hist1D(histograms_, "z", buffers_);
+
+        snapshots_.start(getHistoDirectory(), buffers_);
+    }
+
+    void TrigScintDQM::onProcessEnd() {
+        buffers_.flush();
+        snapshots_.finish();
     }
 
     void TrigScintDQM::configure(Parameters& ps) {
         hitCollectionName_ = ps.getParameter< std::string >("hit_collection");
         padName_ = ps.getParameter< std::string >("pad");
+        buffers_.setBufferSize(ps.getParameter<int>("histogram_buffer_size"));
+        snapshots_.configure(ps, getName());
 
         std::cout << "In TrigScintDQM::configure, got parameters " << hitCollectionName_ << " and " << padName_ << std::endl;
 
@@ -44,11 +61,14 @@ namespace ldmx {
 
     void TrigScintDQM::analyze(const Event & event) { 
 
+        // Count the event and snapshot the histograms if one is due
+        snapshots_.update();
+
         const std::vector<SimCalorimeterHit> TrigScintHits = event.getCollection<SimCalorimeterHit>( hitCollectionName_);
 
         // Get the total hit count
         int hitCount = TrigScintHits.size();  
-        histograms_.fill("n_hits",hitCount);
+        nHits_.fill(hitCount);
 
         double totalEnergy{0};  
         for (const SimCalorimeterHit &hit : TrigScintHits ) {
@@ -57,19 +77,19 @@ namespace ldmx {
 
             int bar = detID.bar();
 
-            histograms_.fill("energy",hit.getEdep()); 
-            histograms_.fill("hit_time",hit.getTime());
-            histograms_.fill("id", bar );
+            energy_.fill(hit.getEdep()); 
+            hitTime_.fill(hit.getTime());
+            id_.fill(bar );
 
             std::vector<float> posvec = hit.getPosition();
-            histograms_.fill("x", posvec.at(0) );
-            histograms_.fill("y", posvec.at(1) );
-            histograms_.fill("z", posvec.at(2) );
+            x_.fill(posvec.at(0) );
+            y_.fill(posvec.at(1) );
+            z_.fill(posvec.at(2) );
 
             totalEnergy += hit.getEdep(); 
         }
 
-        histograms_.fill("total_energy",totalEnergy);
+        totalEnergy_.fill(totalEnergy);
 
     }
 
@@ -44,24 +44,46 @@ namespace ldmx {
 
         // TODO: implement getting a list of the constructed histograms, to iterate through and set overflow boolean. 
 
+        nHits_      = Hist1D(histograms_, "n_hits", buffers_);
+        totalPE_    = Hist1D(histograms_, "total_pe", buffers_);
+        nHitsNoise_ = Hist1D(histograms_, "n_hits_noise", buffers_);
+        pe_         = Hist1D(histograms_, "pe", buffers_);
+        hitTime_    = Hist1D(histograms_, "hit_time", buffers_);
+        id_         = Hist1D(histograms_, "id", buffers_);
+        peNoise_    = Hist1D(histograms_, "pe_noise", buffers_);
+        idNoise_    = Hist1D(histograms_, "id_noise", buffers_);
+        x_          = Hist1D(histograms_, "x", buffers_);
+        y_          = Hist1D(histograms_, "y", buffers_);
+        z_          = Hist1D(histograms_, "z", buffers_);
+
+        snapshots_.start(getHistoDirectory(), buffers_);
+    }
+
+    void TrigScintHitDQM::onProcessEnd() {
+        buffers_.flush();
+        snapshots_.finish();
     }
 
     void TrigScintHitDQM::configure(Parameters& ps) {
         hitCollectionName_ = ps.getParameter< std::string >("hit_collection");
         padName_ = ps.getParameter< std::string >("pad").c_str();
+        buffers_.setBufferSize(ps.getParameter<int>("histogram_buffer_size"));
+        snapshots_.configure(ps, getName());
 
         std::cout << "In TrigScintHitDQM::configure, got parameters " << hitCollectionName_ << " and " << padName_ << std::endl;
     }
 
     void TrigScintHitDQM::analyze(const Event & event) { 
 
+        // Count the event and snapshot the histograms if one is due
+        snapshots_.update();
       
         // Get the collection of TrigScintHit digitized hits if the exists 
         const std::vector<TrigScintHit> TrigScintHits = event.getCollection<TrigScintHit>( hitCollectionName_);
       
         // Get the total hit count
         int hitCount = TrigScintHits.size();  
-        histograms_.fill("n_hits",hitCount); 
+        nHits_.fill(hitCount); 
       
         double totalPE{0};  
         int noiseHitCount = 0;
@@ -70,25 +92,25 @@ namespace ldmx {
 
         for (const TrigScintHit &hit : TrigScintHits ) {
     
-            histograms_.fill("pe",hit.getPE());  
-            histograms_.fill("hit_time",hit.getTime());
-            histograms_.fill("id",hit.getBarID() );
+            pe_.fill(hit.getPE());  
+            hitTime_.fill(hit.getTime());
+            id_.fill(hit.getBarID() );
       
             totalPE += hit.getPE();  
             if ( hit.isNoise()>0 ) {
                 noiseHitCount++;
-                histograms_.fill("pe_noise",hit.getPE()); 
-                histograms_.fill("id_noise",hit.getBarID() );
+                peNoise_.fill(hit.getPE()); 
+                idNoise_.fill(hit.getBarID() );
             } else {  //x, y, z not set for noise hits 
-                histograms_.fill("x", hit.getXPos() );
-                histograms_.fill("y", hit.getYPos() );
-                histograms_.fill("z", hit.getZPos() );
+                x_.fill(hit.getXPos() );
+                y_.fill(hit.getYPos() );
+                z_.fill(hit.getZPos() );
             }
 
         }
         
-        histograms_.fill("total_pe",totalPE); 
-        histograms_.fill("n_hits_noise",noiseHitCount); 
+        totalPE_.fill(totalPE); 
+        nHitsNoise_.fill(noiseHitCount); 
 
     }
 
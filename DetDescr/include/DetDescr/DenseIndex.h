@@ -0,0 +1,220 @@
+/**
+ * @file DenseIndex.h
+ * @brief Bijections between the IDs of a subdetector and a dense range of integers
+ */
+
+#ifndef DETDESCR_DENSEINDEX_H_
+#define DETDESCR_DENSEINDEX_H_
+
+// STL
+#include <array>
+#include <cstddef>
+#include <string>
+
+// LDMX
+#include "Framework/Exception/Exception.h"
+#include "DetDescr/EcalID.h"
+#include "DetDescr/EcalTriggerID.h"
+#include "DetDescr/HcalID.h"
+#include "DetDescr/TrigScintID.h"
+
+namespace ldmx {
+
+    /**
+     * @struct DenseIndexFields
+     * @brief Which fields of an ID type make up its dense index
+     *
+     * Each specialization lists the fields from slowest to fastest varying,
+     * knows how to get them from and put them into an ID, and says which
+     * IDs of the type can be indexed by those fields at all.
+     *
+     * @tparam IDType the ID class
+     */
+    template<class IDType> struct DenseIndexFields;
+
+    template<> struct DenseIndexFields<EcalID> {
+        static constexpr std::size_t N{3};
+        /// only the global precision cells, make() can't build the other cell types
+        static bool indexed(EcalID id) { return id.cell_type() == EcalID::PrecisionGlobal; }
+        static std::array<unsigned int,N> get(EcalID id) {
+            return {unsigned(id.layer()), unsigned(id.module()), unsigned(id.cell())};
+        }
+        static EcalID make(const std::array<unsigned int,N>& f) {
+            return EcalID(f[0],f[1],f[2]);
+        }
+    };
+
+    template<> struct DenseIndexFields<EcalTriggerID> {
+        static constexpr std::size_t N{3};
+        static bool indexed(EcalTriggerID) { return true; }
+        static std::array<unsigned int,N> get(EcalTriggerID id) {
+            return {unsigned(id.layer()), unsigned(id.module()), unsigned(id.triggercell())};
+        }
+        static EcalTriggerID make(const std::array<unsigned int,N>& f) {
+            return EcalTriggerID(f[0],f[1],f[2]);
+        }
+    };
+
+    template<> struct DenseIndexFields<HcalID> {
+        static constexpr std::size_t N{3};
+        static bool indexed(HcalID) { return true; }
+        static std::array<unsigned int,N> get(HcalID id) {
+            return {unsigned(id.section()), unsigned(id.layer()), unsigned(id.strip())};
+        }
+        static HcalID make(const std::array<unsigned int,N>& f) {
+            return HcalID(f[0],f[1],f[2]);
+        }
+    };
+
+    template<> struct DenseIndexFields<TrigScintID> {
+        static constexpr std::size_t N{2};
+        static bool indexed(TrigScintID) { return true; }
+        static std::array<unsigned int,N> get(TrigScintID id) {
+            return {unsigned(id.module()), unsigned(id.bar())};
+        }
+        static TrigScintID make(const std::array<unsigned int,N>& f) {
+            return TrigScintID(f[0],f[1]);
+        }
+    };
+
+    /**
+     * @class DenseIndex
+     * @brief Bijection between the IDs of one subdetector and [0,size())
+     *
+     * The fields of the ID are the digits of a mixed-radix number with
+     * the last field varying fastest, so e.g. the EcalID index is
+     * (layer*nModules+module)*nCells+cell. The extent of each field comes
+     * from the geometry; IDs with a field outside of its extent, or of a cell
+     * type the fields don't cover (e.g. local Ecal cells), are not in the index.
+     *
+     * This lets downstream code key flat arrays (or bitmaps) by ID instead
+     * of using an ordered map, and a DenseIndex with the same extents
+     * always gives the same indices.
+     *
+     * @tparam IDType the ID class, must have a DenseIndexFields specialization
+     */
+    template<class IDType>
+    class DenseIndex {
+
+        public:
+
+            /// Fields of the ID used in the index
+            typedef DenseIndexFields<IDType> Fields;
+
+            /// Number of fields in the index
+            static constexpr std::size_t N{Fields::N};
+
+            /**
+             * Constructor
+             *
+             * @param[in] extents number of values of each field, slowest first
+             */
+            DenseIndex(const std::array<unsigned int,N>& extents) : extents_(extents) {
+                size_ = 1;
+                for (std::size_t i = N; i-- > 0;) {
+                    strides_[i] = size_;
+                    size_ *= extents_[i];
+                }
+            }
+
+            /**
+             * @return number of IDs in the index
+             */
+            std::size_t size() const { return size_; }
+
+            /**
+             * @return number of values of each field, slowest first
+             */
+            const std::array<unsigned int,N>& getExtents() const { return extents_; }
+
+            /**
+             * Check if the input ID is in the index
+             *
+             * @param[in] id ID to check
+             * @return true if the ID can be indexed and all of its fields are within their extents
+             */
+            bool contains(IDType id) const {
+                if (id.null() || !Fields::indexed(id)) return false;
+                auto f = Fields::get(id);
+                for (std::size_t i = 0; i < N; i++) {
+                    if (f[i] >= extents_[i]) return false;
+                }
+                return true;
+            }
+
+            /**
+             * Get the index of the input ID
+             *
+             * @throw Exception if the ID is not in the index
+             *
+             * @param[in] id ID to get the index of
+             * @return index in [0,size())
+             */
+            std::size_t index(IDType id) const {
+                if (id.null()) {
+                    EXCEPTION_RAISE("InvalidIdException", "Null ID is not in the dense index.");
+                }
+                if (!Fields::indexed(id)) {
+                    EXCEPTION_RAISE("InvalidIdException", "ID " + std::to_string(id.raw())
+                            + " is of a type the dense index doesn't cover.");
+                }
+                auto f = Fields::get(id);
+                std::size_t idx = 0;
+                for (std::size_t i = 0; i < N; i++) {
+                    if (f[i] >= extents_[i]) {
+                        EXCEPTION_RAISE("InvalidIdException", "ID " + std::to_string(id.raw())
+                                + " has field " + std::to_string(i) + " = " + std::to_string(f[i])
+                                + " outside of the dense index extent " + std::to_string(extents_[i]) + ".");
+                    }
+                    idx += f[i]*strides_[i];
+                }
+                return idx;
+            }
+
+            /**
+             * Get the ID at the input index
+             *
+             * @throw Exception if the index is not in [0,size())
+             *
+             * @param[in] index index to get the ID of
+             * @return ID at that index
+             */
+            IDType id(std::size_t index) const {
+                if (index >= size_) {
+                    EXCEPTION_RAISE("InvalidIdException", "Index " + std::to_string(index)
+                            + " is outside of the dense index of size " + std::to_string(size_) + ".");
+                }
+                std::array<unsigned int,N> f;
+                for (std::size_t i = 0; i < N; i++) {
+                    f[i] = index / strides_[i];
+                    index %= strides_[i];
+                }
+                return Fields::make(f);
+            }
+
+        private:
+
+            /// number of values of each field
+            std::array<unsigned int,N> extents_;
+
+            /// step in the index for one step in each field
+            std::array<std::size_t,N> strides_;
+
+            /// total number of IDs in the index
+            std::size_t size_;
+    };
+
+    /// Index over (layer, module, cell)
+    typedef DenseIndex<EcalID> EcalDenseIndex;
+
+    /// Index over (layer, module, trigger cell)
+    typedef DenseIndex<EcalTriggerID> EcalTriggerDenseIndex;
+
+    /// Index over (section, layer, strip)
+    typedef DenseIndex<HcalID> HcalDenseIndex;
+
+    /// Index over (module, bar)
+    typedef DenseIndex<TrigScintID> TrigScintDenseIndex;
+}
+
+#endif
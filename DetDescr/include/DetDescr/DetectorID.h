@@ -3,6 +3,7 @@
 #define DETDESCR_DETECTORID_H_
 
 #include <cstdint>
+#include <functional>
 #include <iostream>
 #include "Framework/Exception/Exception.h"
 
@@ -97,7 +98,23 @@ namespace ldmx {
 
     };
 
+    /**
+     * @struct DetectorIDHash
+     * @brief Hash for DetectorID and the IDs derived from it
+     *
+     * The raw value is already unique, so it is used directly.
+     * The std::hash specializations for each ID type derive from this.
+     */
+    struct DetectorIDHash {
+        std::size_t operator()(const DetectorID& id) const noexcept {
+            return std::hash<DetectorID::RawValue>{}(id.raw());
+        }
+    };
+
+}
 
+namespace std {
+    template<> struct hash<ldmx::DetectorID> : ldmx::DetectorIDHash { };
 }
 
 #define SUBDETECTORID_TEST(a,x) if (!null() && !(subdet()==x)) { EXCEPTION_RAISE("DetectorIDMismatch","Attempted to create "+std::string(a)+" from mismatched source "+std::to_string(subdet())); }
@@ -2,6 +2,7 @@
 #define DETDESCR_DETECTORIDINTERPRETER_H
 
 // STL
+#include <array>
 #include <vector>
 #include <iostream>
 
@@ -20,6 +21,11 @@ namespace ldmx {
      * be unpacked into a list of field values or packed from a list of field
      * values.
      *
+     * The field layouts are looked up in a table indexed by the 6-bit
+     * subdetector field, so only the few layouts sharing a subdetector
+     * (e.g. the different Ecal cell types) need to be compared to the ID.
+     * The unpacked field values are kept in a fixed-size array so decoding
+     * does not allocate.
      */
     class DetectorIDInterpreter {
 
@@ -29,15 +35,74 @@ namespace ldmx {
 
             ~DetectorIDInterpreter();
 
+            /**
+             * Layout of the fields for one format of ID
+             */
+            struct SubdetectorIDFields {
+                /// bits beyond the subdetector field which determine the format
+                unsigned int mask_;
+                /// value of the bits in mask_ for this format
+                unsigned int comparison_;
+                /// the fields in this format
+                IDField::IDFieldList fieldList_;
+            };
+
+            /**
+             * @class Registry
+             * @brief Read-only table of the field layouts for all of the subdetectors
+             *
+             * The registry is built exactly once, the first time it is needed,
+             * and is never modified afterwards. Lookups therefore need no locking
+             * and can be done concurrently from any number of threads.
+             */
+            class Registry {
+                public:
+                    /**
+                     * Find the layout for the input ID
+                     *
+                     * The layouts of a subdetector are tried in the order they were added.
+                     *
+                     * @param id ID to find the layout for
+                     * @return layout of the ID, the generic layout if nothing matches
+                     * or nullptr for a null ID
+                     */
+                    const SubdetectorIDFields* find(DetectorID id) const;
+
+                private:
+                    friend class DetectorIDInterpreter;
+
+                    /**
+                     * Add a layout, checking that it doesn't replace one with the same mask and equality
+                     */
+                    void add(SubdetectorIDType idtype, unsigned int mask, unsigned int equality, const IDField::IDFieldList& fieldList);
+
+                    /// layouts for each subdetector (index is the subdetector field)
+                    std::array<std::vector<SubdetectorIDFields>,DetectorID::SUBDETECTORID_MASK+1> layouts_;
+            };
+
+            /**
+             * Get the registry of field layouts, building it on first use.
+             *
+             * This is safe to call from multiple threads.
+             *
+             * @return the frozen registry of layouts
+             */
+            static const Registry& registry();
+
             /**
              * Definition of the field value type.
              */
             typedef unsigned FieldValue;
 
+            /**
+             * Maximum number of fields in an ID layout.
+             */
+            static constexpr unsigned int MAX_FIELDS{8};
+
             /**
              * A list of field values.
              */
-            typedef std::vector<FieldValue> FieldValueList;
+            typedef std::array<FieldValue,MAX_FIELDS> FieldValueList;
 
             /**
              * Get the raw value of the detector ID.
@@ -97,6 +162,31 @@ namespace ldmx {
              */
             FieldValue getFieldValue(const std::string& fieldName) const;
 
+            /** 
+             * Register a new field interpreter for a given subdetector id
+             *
+             * @param idtype subdetector that this layout is for
+             * @param fields constexpr array of fields in the layout
+             */
+            template <std::size_t N>
+            static void registerInterpreter(SubdetectorIDType idtype, const IDField (&fields)[N]) {
+                registerInterpreter(idtype,0,0,fields);
+            }
+
+            /** 
+             * Register a new field interpreter for a more-complex case where additional bits are needed to determine format
+             *
+             * @param idtype subdetector that this layout is for
+             * @param mask bits beyond the subdetector field that determine the format
+             * @param equality value of the bits in mask for this format
+             * @param fields constexpr array of fields in the layout
+             */
+            template <std::size_t N>
+            static void registerInterpreter(SubdetectorIDType idtype, unsigned int mask, unsigned int equality, const IDField (&fields)[N]) {
+                static_assert(N <= MAX_FIELDS, "Too many fields in DetectorID layout.");
+                registerInterpreter(idtype,mask,equality,IDField::IDFieldList(fields,fields+N));
+            }
+
             /** 
              * Register a new field interpreter for a given subdetector id
              */
@@ -104,16 +194,20 @@ namespace ldmx {
 
             /** 
              * Register a new field interpreter for a more-complex case where additional bits are needed to determine format
+             *
+             * @note Interpreters can only be registered by the createInterpreters
+             * functions called from loadStandardInterpreters while the registry is
+             * being built. Afterwards the registry is frozen and this throws.
              */
             static void registerInterpreter(SubdetectorIDType idtype, unsigned int mask, unsigned int equality,  const IDField::IDFieldList& fieldList);		    
 
         private:
 
             /** 
-             * Load the standard field interpreters if not yet loaded.
+             * Build the registry of the standard field interpreters.
              * @important Developers of new Ids should add construction calls here!
              */
-            static void loadStandardInterpreters();
+            static Registry loadStandardInterpreters();
 
             /**
              * Reinitialize the ID in case the field list changed.
@@ -148,20 +242,6 @@ namespace ldmx {
             FieldValueList fieldValues_;
 
 
-            struct SubdetectorIDFields {
-                IDField::IDFieldMap fieldMap_;
-                IDField::IDFieldList fieldList_;
-            };
-
-	    struct IDSignature {
-	        unsigned int mask_;
-	        unsigned int comparison_;
-		bool operator<(const IDSignature& id) const { return (comparison_&mask_)<(id.comparison_&id.mask_); }
-	    };
-	
-            static std::map<IDSignature, const SubdetectorIDFields*> g_rosettaStone;
-          
-
             /**
              * Pointer to the appropriate field info for this class
              */
@@ -73,4 +73,8 @@ namespace ldmx {
 
 
 
+namespace std {
+    template<> struct hash<ldmx::EcalAbstractID> : ldmx::DetectorIDHash { };
+}
+
 #endif
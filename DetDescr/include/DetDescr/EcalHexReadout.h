@@ -15,11 +15,14 @@
 // LDMX
 #include "Framework/Exception/Exception.h"
 #include "DetDescr/EcalID.h"
+#include "DetDescr/DenseIndex.h"
 #include "Framework/Configure/Parameters.h"
 #include "Framework/ConditionsObject.h"
 
 // STL
+#include <cmath>
 #include <map>
+#include <vector>
 
 // ROOT
 #include "TH2Poly.h"
@@ -77,29 +80,64 @@ namespace ldmx {
              *
              * @sa getCellCenterAbsolute and getZPosition
              *
+             * @throw Exception (InvalidCellID) if the module or cell is not in the geometry.
+             * @throw std::out_of_range if the layer is not in the geometry.
+             *
              * @param[in] id EcalID for the cell we want the position of
              * @param[out] x set to x-coordinate of cell center
              * @param[out] y set to y-coordinate of cell center
              * @param[out] z set to z-coordinate of cell center
              */
             void getCellAbsolutePosition( EcalID id, double &x, double &y, double &z ) const {
-                
-                std::pair<double,double> xy = this->getCellCenterAbsolute( EcalID(0,id.module(),id.cell()) );
+                const auto& xy = cellModulePositions_[getCellModuleIndex(id)];
                 x = xy.first;
                 y = xy.second;
                 z = getZPosition(id.layer());
-
                 return;
             }
 
             /**
              * Get the z-coordinate given the layer id
              *
+             * @throw std::out_of_range if the layer is not in the geometry
+             *
              * @param[in] layer int layer id
              * @return z-coordinate of the input sensitive layer
              */
             double getZPosition(int layer) const {
-                return ecalFrontZ_ + layerZPositions_.at(layer);
+                return layerZAbsolute_.at(layer);
+            }
+
+            /**
+             * Get the index of the input cell in the flat cell-module tables.
+             *
+             * The index is module*(cells per module)+cell, so it runs over
+             * [0, modules per layer * cells per module) and ignores the layer.
+             *
+             * @throw Exception (InvalidCellID) if the module or cell is not in the geometry.
+             *
+             * @param[in] id EcalID where all we care about is module and cell
+             * @return index into the flat cell-module tables
+             */
+            unsigned int getCellModuleIndex(EcalID id) const {
+                unsigned int module = id.module(), cell = id.cell();
+                if (module >= nModules_ or cell >= nCellsPerModule_) {
+                    EXCEPTION_RAISE( "InvalidCellID" , "Module " + std::to_string(module) 
+                            + " and cell " + std::to_string(cell) + " are not in the geometry." );
+                }
+                return module*nCellsPerModule_ + cell;
+            }
+
+            /**
+             * Get the dense index over all of the cells in this geometry.
+             *
+             * The index is (layer*modules per layer+module)*cells per module+cell,
+             * so its cell-module part matches getCellModuleIndex.
+             *
+             * @return index over (layer, module, cell)
+             */
+            EcalDenseIndex getDenseIndex() const {
+                return EcalDenseIndex({unsigned(layerZAbsolute_.size()), nModules_, nCellsPerModule_});
             }
 
             /**
@@ -139,14 +177,14 @@ namespace ldmx {
              */
             int getModuleID(double x, double y) const {
                 int bestID = -1;
-                double bestDist = 1E6;
-                for(auto const& module : modulePositionMap_) {  
-                    int mID   = module.first;
-                    double mX = module.second.first;
-                    double mY = module.second.second;
-                    double dist = sqrt( (x-mX)*(x-mX) + (y-mY)*(y-mY) );
-                    if(dist < moduler_) return mID;
-                    if(dist < bestDist) { bestID = mID; bestDist = dist; }
+                double bestDist2 = 1E12;
+                double moduler2 = moduler_*moduler_;
+                for(unsigned int mID = 0; mID < modulePositions_.size(); mID++) {
+                    double dX = x - modulePositions_[mID].first;
+                    double dY = y - modulePositions_[mID].second;
+                    double dist2 = dX*dX + dY*dY;
+                    if(dist2 < moduler2) return mID;
+                    if(dist2 < bestDist2) { bestID = mID; bestDist2 = dist2; }
                 }
                 return bestID;
             }
@@ -161,11 +199,17 @@ namespace ldmx {
              * we could return a special cell ID (-1 for example) that signals that this hit
              * is in a dead region.
              *
+             * Cells that are far enough from the module edge are found directly
+             * from the hexagonal lattice (see getLatticeCellID), only the cells
+             * near the clipped edge polygons need the TH2Poly search.
+             *
              * @param x Any X position [mm]
              * @param y Any Y position [mm]
              * @return local cell ID to the module
              */
             int getCellIDRelative(double x, double y) const {
+                int cell = getLatticeCellID(x,y);
+                if(cell >= 0) return cell;
                 int bin = ecalMap_.FindBin(x,y)-1; // NB FindBin indices starts from 1, our maps start from 0
                 if(bin < 0) {
                     TString error_msg = TString("[EcalHexReadout::getCellIDRelative] Relative coordinates are outside module hexagon!") + 
@@ -182,7 +226,7 @@ namespace ldmx {
              * @returns number of cells in the ecal module
              */
             int getNumCellsPerModule() const {
-                return ecalMap_.GetNumberOfBins();
+                return nCellsPerModule_;
             }
 
             /**
@@ -194,13 +238,10 @@ namespace ldmx {
              * @return The (x,y) position of the center of the cell.
              */
             std::pair<double,double> getCellCenterRelative(int cellID) const {
-                // this map search is probably just as fine as the TList search for the cell in ecalMap.
-                //   wonder why TH2Poly->GetBin(ID) doesn't exist. plus the map is useful by itself.
-                auto search = cellPositionMap_.find(cellID);
-                if(search == cellPositionMap_.end()) {
+                if(cellID < 0 or cellID >= int(cellPositions_.size())) {
                     EXCEPTION_RAISE( "InvalidCellID" , "Cell " + std::to_string(cellID) + " is not valid." );
                 }
-                return search->second;
+                return cellPositions_[cellID];
             }
 
             /**
@@ -214,8 +255,8 @@ namespace ldmx {
              */
             EcalID getCellModuleID(double x, double y) const {
                 int moduleID = getModuleID(x,y);
-                double relX = x - modulePositionMap_.at(moduleID).first;
-                double relY = y - modulePositionMap_.at(moduleID).second;
+                double relX = x - modulePositions_[moduleID].first;
+                double relY = y - modulePositions_[moduleID].second;
                 int cellID = getCellIDRelative(relX,relY);
                 return EcalID(0,moduleID,cellID);
             }
@@ -223,13 +264,15 @@ namespace ldmx {
             /**
              * Get a cell center XY position relative to ecal center from a combined cellModuleID.
              *
-             * @throw std::out_of_range if EcalID isn't created with valid cell or module IDs.
+             * @throw Exception (InvalidCellID) if EcalID isn't created with valid
+             * cell or module IDs. This used to be the std::out_of_range of the
+             * map lookup, so catch Exception (or std::exception) instead.
              *
              * @param cellModuleID EcalID where all we care about is module and cell
              * @return The XY position of the center of the cell.
              */
             std::pair<double,double> getCellCenterAbsolute(EcalID cellModuleID) const {
-                return cellModulePositionMap_.at(EcalID(0,cellModuleID.module(),cellModuleID.cell()));
+                return cellModulePositions_[getCellModuleIndex(cellModuleID)];
             }
 
             /**
@@ -264,56 +307,94 @@ namespace ldmx {
              */
             bool isInside(double normX, double normY) const;
 
+            /**
+             * @class CellRange
+             * @brief A view of a contiguous list of cell-module IDs in the neighbor tables
+             *
+             * The IDs in the range have their layer set to zero.
+             * The range is only valid as long as the EcalHexReadout it came from.
+             */
+            class CellRange {
+                public:
+                    CellRange(const EcalID* begin, const EcalID* end) : begin_{begin}, end_{end} { }
+                    const EcalID* begin() const { return begin_; }
+                    const EcalID* end() const { return end_; }
+                    std::size_t size() const { return end_-begin_; }
+                    bool empty() const { return begin_==end_; }
+                    const EcalID& operator[](std::size_t i) const { return begin_[i]; }
+                private:
+                    const EcalID* begin_;
+                    const EcalID* end_;
+            };
+
+            /**
+             * Get the Nearest Neighbors of the input ID without copying
+             *
+             * @param id id to get neighbors of, only module and cell are used
+             * @return range of EcalID (layer zero) that are the inputs nearest neighbors
+             */
+            CellRange getNNRange(EcalID id) const {
+                unsigned int index = getCellModuleIndex(id);
+                return CellRange(NNList_.data()+NNOffsets_[index], NNList_.data()+NNOffsets_[index+1]);
+            }
+
             /**
              * Get the Nearest Neighbors of the input ID
              *
              * @param id id to get
-             * @return list of EcalID that are the inputs nearest neighbors
+             * @return list of EcalID that are the inputs nearest neighbors (in the same layer as id)
              */
             std::vector<EcalID> getNN(EcalID id) const {
-                auto list = NNMap_.at(EcalID(0,id.module(),id.cell()));
-                for (auto& flat : list) id = EcalID(id.layer(),flat.module(),flat.cell());
-                return list;
+                return inLayer(getNNRange(id),id.layer());
             }
 
             /**
              * Check if the probe id is one of the nearest neightbors of the centroid id
              *
+             * Only the short list of neighbors of the centroid is scanned,
+             * nothing is allocated.
+             *
              * @param probe id to check if it is nearest neighbor
              * @param centroid id that is center of neighbors
              * @return true if probe ID is a nearest neighbor of the centroid
              */
             bool isNN(EcalID centroid, EcalID probe) const {
-                for ( auto& id : getNN(centroid) ) {
-                    if ( id == probe ) return true;
-                } 
-                return false;
+                return inRange(getNNRange(centroid),centroid,probe);
+            }
+
+            /**
+             * Get the Next-to-Nearest Neighbors of the input ID without copying
+             *
+             * @param id id to get neighbors of, only module and cell are used
+             * @return range of EcalID (layer zero) that are the inputs next-to-nearest neighbors
+             */
+            CellRange getNNNRange(EcalID id) const {
+                unsigned int index = getCellModuleIndex(id);
+                return CellRange(NNNList_.data()+NNNOffsets_[index], NNNList_.data()+NNNOffsets_[index+1]);
             }
 
             /**
              * Get the Next-to-Nearest Neighbors of the input ID
              *
              * @param id id to get
-             * @return list of EcalID that are the inputs next-to-nearest neighbors
+             * @return list of EcalID that are the inputs next-to-nearest neighbors (in the same layer as id)
              */
             std::vector<EcalID> getNNN(EcalID id) const {
-                auto list = NNNMap_.at(EcalID(0,id.module(),id.cell()));
-                for (auto& flat : list) id = EcalID(id.layer(),flat.module(),flat.cell());
-                return list;
+                return inLayer(getNNNRange(id),id.layer());
             }
 
             /**
              * Check if the probe id is one of the next-to-nearest neightbors of the centroid id
              *
+             * Only the short list of neighbors of the centroid is scanned,
+             * nothing is allocated.
+             *
              * @param probe id to check if it is a next-to-nearest neighbor
              * @param centroid id that is center of neighbors
              * @return true if probe ID is a next-to-nearest neighbor of the centroid
              */
             bool isNNN(EcalID centroid, EcalID probe) const {
-                for ( auto& id : getNNN(centroid) ) {
-                    if ( id == probe ) return true;
-                } 
-                return false;
+                return inRange(getNNNRange(centroid),centroid,probe);
             }
 
             /**
@@ -434,35 +515,126 @@ namespace ldmx {
              * @param[in] moduleR_ the center-to-flat module radius
              * @param[out] ecalMap_ TH2Poly with local cell ID to local cell position mapping
              * @param[out] cellPostionMap_ map of local cell ID to cell center position relative to module
+             * @param[out] clippedCells_ list of whether each cell ID was clipped by the module edge
              */
             void buildCellMap();
 
+            /**
+             * Constructs the lookup table from hexagonal lattice coordinates to cell IDs.
+             *
+             * The cell centers form a lattice of corner-up hexagons with center-to-corner
+             * radius cellR_, so a position can be converted to axial lattice coordinates (q,r)
+             * relative to the center of cell 0 and then rounded to the nearest lattice site.
+             *
+             * Only cells whose hexagon is complete and who do not have any clipped cells as
+             * nearest neighbors are put in the table. The clipped edge polygons can poke into
+             * their neighbors (the projected vertices), so positions that round to
+             * any other lattice site are left to the TH2Poly search.
+             *
+             * @param[in] cellPositionMap_ map of cell IDs to cell centers relative to module
+             * @param[in] clippedCells_ which cells were clipped by the module edge
+             * @param[out] latticeCells_ table of (q,r) to cell ID, -1 for sites needing the TH2Poly search
+             */
+            void buildCellLattice();
+
+            /**
+             * Get a cell ID from an XY position relative to the module center using the hexagonal lattice.
+             *
+             * This is the fast path for getCellIDRelative. Cube rounding of the fractional
+             * axial coordinates gives the lattice site whose hexagon contains the point.
+             *
+             * @param x X position relative to module center [mm]
+             * @param y Y position relative to module center [mm]
+             * @return cell ID or -1 if the position needs to be searched for in the TH2Poly
+             */
+            int getLatticeCellID(double x, double y) const {
+                double dx = (x - latticeOriginX_)/cellR_;
+                double dy = (y - latticeOriginY_)/cellR_;
+                double fq = dx/sqrt(3.) - dy/3.;
+                double fr = 2.*dy/3.;
+                double fs = -fq-fr;
+                double q = std::round(fq), r = std::round(fr), s = std::round(fs);
+                double dq = fabs(q-fq), dr = fabs(r-fr), ds = fabs(s-fs);
+                if (dq > dr and dq > ds) q = -r-s;
+                else if (dr > ds) r = -q-s;
+                int col = int(q) - latticeMinQ_;
+                int row = int(r) - latticeMinR_;
+                if (col < 0 or col >= latticeNumQ_ or row < 0 or row >= latticeNumR_) return -1;
+                return latticeCells_[row*latticeNumQ_+col];
+            }
+
             /**
              * Constructs the positions of all the cells in a layer relative to the ecal center.
              *
              * This uses the modulePostionMap_ and cellPositionMap_ to calculate the center
              * of all cells relative to the ecal center.
              *
+             * The same positions are also stored in flat tables indexed by cell ID and by
+             * getCellModuleIndex along with the absolute layer z-coordinates, so that the
+             * per-hit position lookups are single loads instead of map searches.
+             *
              * @param[in] modulePositionMap_ map of module IDs to module centers relative to ecal
              * @param[in] cellPositionMap_ map of cell IDs to cell centers relative to module
-             * @param[out]
+             * @param[out] cellModulePositionMap_ map of cells to cell centers relative to ecal
+             * @param[out] cellPositions_ cell centers relative to module indexed by cell ID
+             * @param[out] cellModulePositions_ cell centers relative to ecal indexed by getCellModuleIndex
+             * @param[out] layerZAbsolute_ z-coordinates of the sensitive layers indexed by layer ID
              */
             void buildCellModuleMap();
 
             /**
-             * Construts NNMap and NNNMap
+             * Construts the NN and NNN tables
+             *
+             * This is done every time the geometry is constructed, so rather than
+             * comparing every pair of cells, the cell centers are binned in a square grid
+             * with a bin width of the largest neighbor distance and only the cells in the
+             * surrounding bins are checked to see if they are within multiples of the
+             * cellular radius of each other.
              *
-             * Since this only occurs once during processing, we can be wasteful.
-             * We do a nested loop over the entire cellular position map and calculate
-             * neighbors by seeing which cells are within multiples of the cellular radius
-             * of each other.
+             * The neighbors are stored in compressed-sparse-row form: the neighbors of the cell
+             * with index i (see getCellModuleIndex) are the entries [offsets[i], offsets[i+1]) of the list.
              *
-             * @param[in] cellModulePostionMap_ map of cells to cell centers relative to ecal
-             * @param[out] NNMap_ map of cell IDs to list of cell IDs that are its nearest neighbors
-             * @param[out] NNNMap_ map of cell IDs to list of cell IDs that are its next-to-nearest neighbors
+             * @param[in] cellModulePositions_ cell centers relative to ecal indexed by getCellModuleIndex
+             * @param[out] NNOffsets_ start of each cell's nearest neighbors in NNList_
+             * @param[out] NNList_ cell IDs of the nearest neighbors of all cells
+             * @param[out] NNNOffsets_ start of each cell's next-to-nearest neighbors in NNNList_
+             * @param[out] NNNList_ cell IDs of the next-to-nearest neighbors of all cells
              */
             void buildNeighborMaps();
 
+            /**
+             * Copy the input range of layer-zero IDs into a list with the input layer
+             *
+             * @param range list of neighbors from the neighbor tables
+             * @param layer layer to put the IDs in
+             * @return list of IDs with the layer set
+             */
+            static std::vector<EcalID> inLayer(const CellRange& range, int layer) {
+                std::vector<EcalID> list;
+                list.reserve(range.size());
+                for (auto const& flat : range) list.emplace_back(layer,flat.module(),flat.cell());
+                return list;
+            }
+
+            /**
+             * Check if the probe is in the input range of neighbors of the centroid
+             *
+             * The probe needs to be in the same layer as the centroid.
+             *
+             * @param range list of neighbors of centroid from the neighbor tables
+             * @param centroid id that is center of neighbors
+             * @param probe id to check
+             * @return true if probe is in the range and the same layer as the centroid
+             */
+            static bool inRange(const CellRange& range, EcalID centroid, EcalID probe) {
+                if (probe.layer() != centroid.layer()) return false;
+                EcalID flatProbe(0,probe.module(),probe.cell());
+                for (auto const& id : range) {
+                    if (id == flatProbe) return true;
+                }
+                return false;
+            }
+
             /**
              * Constructs list of trigger groups.
              *
@@ -518,11 +690,59 @@ namespace ldmx {
             /// Position of cell centers relative to world geometry (uses ID with real cell and module and layer as zero for key)
             std::map<EcalID, std::pair<double,double>> cellModulePositionMap_;
 
-            /// Map of cell ID to neighboring cells (uses ID with real cell and module and layer as zero for key)
-            std::map<EcalID, std::vector<EcalID> > NNMap_;
+            /// Postion of module centers relative to world geometry (index is module ID)
+            std::vector<std::pair<double,double>> modulePositions_;
+
+            /// Whether each cell had its polygon clipped by the module edge (index is cell ID)
+            std::vector<bool> clippedCells_;
+
+            /// X position of the lattice origin (center of cell 0) relative to module [mm]
+            double latticeOriginX_{0};
+
+            /// Y position of the lattice origin (center of cell 0) relative to module [mm]
+            double latticeOriginY_{0};
+
+            /// Minimum axial q coordinate in latticeCells_
+            int latticeMinQ_{0};
+
+            /// Minimum axial r coordinate in latticeCells_
+            int latticeMinR_{0};
+
+            /// Number of q coordinates in latticeCells_
+            int latticeNumQ_{0};
+
+            /// Number of r coordinates in latticeCells_
+            int latticeNumR_{0};
+
+            /// Cell IDs at each lattice site (index is (r-latticeMinR_)*latticeNumQ_+(q-latticeMinQ_)), -1 for none
+            std::vector<int> latticeCells_;
+
+            /// Number of modules in a layer
+            unsigned int nModules_{0};
+
+            /// Number of cells in a module
+            unsigned int nCellsPerModule_{0};
+
+            /// Position of cell centers relative to module (index is cell ID)
+            std::vector<std::pair<double,double>> cellPositions_;
+
+            /// Position of cell centers relative to world geometry (index is getCellModuleIndex)
+            std::vector<std::pair<double,double>> cellModulePositions_;
+
+            /// Z position of the sensitive layers relative to world geometry (index is layer ID) [mm]
+            std::vector<double> layerZAbsolute_;
+
+            /// Start of the nearest neighbors of each cell in NNList_ (index is getCellModuleIndex, one extra entry at the end)
+            std::vector<unsigned int> NNOffsets_;
+
+            /// Nearest neighbors of all cells (layer as zero)
+            std::vector<EcalID> NNList_;
+
+            /// Start of the next-to-nearest neighbors of each cell in NNNList_ (index is getCellModuleIndex, one extra entry at the end)
+            std::vector<unsigned int> NNNOffsets_;
 
-            /// Map of cell ID to neighbors of neighbor cells (uses ID with real cell and module and layer as zero for key)
-            std::map<EcalID, std::vector<EcalID> > NNNMap_;
+            /// Next-to-nearest neighbors of all cells (layer as zero)
+            std::vector<EcalID> NNNList_;
 
             /// List of Trigger Group IDs (index is cell ID)
             std::vector<int> triggerGroups_;
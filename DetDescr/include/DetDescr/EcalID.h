@@ -126,6 +126,21 @@ namespace ldmx {
 	 */
 	std::pair<unsigned int,unsigned int> getCellUV() const;
 
+	/**
+	 * Decode the layer, module, and cell fields of a batch of raw IDs.
+	 *
+	 * The IDs are checked once for the whole batch instead of once per ID
+	 * and the decoding is a plain shift-and-mask loop over the batch,
+	 * so the compiler can vectorize both passes.
+	 *
+	 * @param[in] ids pointer to the first of n raw ID values
+	 * @param[in] n number of IDs in the batch
+	 * @param[out] layers array of at least n entries to fill with the layer field
+	 * @param[out] modules array of at least n entries to fill with the module field
+	 * @param[out] cells array of at least n entries to fill with the cell field
+	 * @throws DetectorIDMismatch if any non-null ID is not a precision Ecal ID
+	 */
+	static void unpack(const RawValue* ids, std::size_t n, int* layers, int* modules, int* cells);
 
 	static void createInterpreters();
     };
@@ -134,4 +149,8 @@ namespace ldmx {
 
 std::ostream& operator<<(std::ostream&, const ldmx::EcalID&);
 
+namespace std {
+    template<> struct hash<ldmx::EcalID> : ldmx::DetectorIDHash { };
+}
+
 #endif
@@ -122,4 +122,8 @@ namespace ldmx {
 
 std::ostream& operator<<(std::ostream&, const ldmx::EcalTriggerID&);
 
+namespace std {
+    template<> struct hash<ldmx::EcalTriggerID> : ldmx::DetectorIDHash { };
+}
+
 #endif
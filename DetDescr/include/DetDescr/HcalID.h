@@ -117,10 +117,29 @@ namespace ldmx {
 	    return (id_>>STRIP_SHIFT) & STRIP_MASK;
 	}
 
+	/**
+	 * Decode the section, layer, and strip fields of a batch of raw IDs.
+	 *
+	 * The subdetector is checked once for the whole batch instead of
+	 * once per ID, see EcalID::unpack.
+	 *
+	 * @param[in] ids pointer to the first of n raw ID values
+	 * @param[in] n number of IDs in the batch
+	 * @param[out] sections array of at least n entries to fill with the section field
+	 * @param[out] layers array of at least n entries to fill with the layer field
+	 * @param[out] strips array of at least n entries to fill with the strip field
+	 * @throws DetectorIDMismatch if any non-null ID is not an Hcal ID
+	 */
+	static void unpack(const RawValue* ids, std::size_t n, int* sections, int* layers, int* strips);
+
 	static void createInterpreters();
     };
 }
 
 std::ostream& operator<<(std::ostream&, const ldmx::HcalID&);
 
+namespace std {
+    template<> struct hash<ldmx::HcalID> : ldmx::DetectorIDHash { };
+}
+
 #endif
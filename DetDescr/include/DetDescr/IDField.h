@@ -3,7 +3,6 @@
 
 // STL
 #include <string>
-#include <map>
 #include <vector>
 
 namespace ldmx {
@@ -11,81 +10,104 @@ namespace ldmx {
     /**
      * @class IDField
      * @brief Provides information about a field within a DetectorID
+     *
+     * This is a literal type so that the field layout of each ID type
+     * can be written down as a constexpr array and checked at compile time.
      */
     class IDField {
 
         public:
 
-            /**
-             * Map of name to field.
-             */
-            typedef std::map<std::string, IDField*> IDFieldMap;
-
             /**
              * List of fields.
              */
-            typedef std::vector<IDField*> IDFieldList;
+            typedef std::vector<IDField> IDFieldList;
 
             /**
              * Class constructor.
-             * @param name The name of the field.
+             * @param name The name of the field, must have static storage duration.
              * @param index The index of the field in the ID.
              * @param startBit The start bit of the field.
              * @param endBit The end bit of the field.
              */
-            IDField(std::string name, unsigned index, unsigned startBit, unsigned endBit);
+            constexpr IDField(const char* name, unsigned index, unsigned startBit, unsigned endBit)
+                : fieldName(name), index(index), startBit(startBit), endBit(endBit),
+                  bitMask(IDField::createBitMask(startBit, endBit)) { }
 
             /**
              * Get the name of the field.
              * @return The name of the field.
              */
-            const std::string& getFieldName();
+            std::string getFieldName() const { return fieldName; }
+
+            /**
+             * Check if this field has the input name.
+             * @param name The name to compare to.
+             * @return true if the name of this field is name
+             */
+            bool hasName(const std::string& name) const { return name == fieldName; }
 
             /**
              * Get the index of the field.
              * @return The index of the field.
              */
-            unsigned getIndex();
+            constexpr unsigned getIndex() const { return index; }
 
             /**
              * Get the start bit of the field.
              * @return The start bit of the field.
              */
-            unsigned getStartBit();
+            constexpr unsigned getStartBit() const { return startBit; }
 
             /**
              * Get the end bit of the field.
              * @return The end bit of the field.
              */
-            unsigned getEndBit();
+            constexpr unsigned getEndBit() const { return endBit; }
 
             /**
              * Get a bit mask for this field.
              * @return A bit mask for this field.
              */
-            unsigned getBitMask();
+            constexpr unsigned getBitMask() const { return bitMask; }
+
+            /**
+             * Decode the value of this field from a raw ID.
+             * @param raw The raw ID.
+             * @return The value of this field.
+             */
+            constexpr unsigned extract(unsigned raw) const { return (raw & bitMask) >> startBit; }
 
             /**
              * Utility for creating a bit mask from a start to end bit.
              * @param startBit The start bit.
              * @param endBit The end bit.
              */
-            static unsigned createBitMask(unsigned startBit, unsigned endBit);
+            static constexpr unsigned createBitMask(unsigned startBit, unsigned endBit) {
+                unsigned mask = 0;
+                for (unsigned i = startBit; i <= endBit; i++) {
+                    mask |= 1u << i;
+                }
+                return mask;
+            }
 
             /**
              * Utility for counting number of 1 in a mask
-             * @param startBit The start bit.
-             * @param endBit The end bit.
+             * @param mask The mask to count.
              */
-            static unsigned countOnes(unsigned mask);
-
+            static constexpr unsigned countOnes(unsigned mask) {
+                unsigned rv=0;
+                for (unsigned i=0; i<32; i++)
+                    if (mask & (1u<<i)) rv++;
+                return rv;
+            }
 
         private:
 
             /**
              * The name of the field.
              */
-            std::string fieldName;
+            const char* fieldName;
 
             /**
              * The index of the field.
@@ -95,4 +95,8 @@ namespace ldmx {
 
 std::ostream& operator<<(std::ostream&, const ldmx::SimSpecialID&);
 
+namespace std {
+    template<> struct hash<ldmx::SimSpecialID> : ldmx::DetectorIDHash { };
+}
+
 #endif
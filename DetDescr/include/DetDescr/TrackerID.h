@@ -73,4 +73,8 @@ namespace ldmx {
 std::ostream& operator<<(std::ostream&, const ldmx::TrackerID&);
 
 
+namespace std {
+    template<> struct hash<ldmx::TrackerID> : ldmx::DetectorIDHash { };
+}
+
 #endif
@@ -82,4 +82,8 @@ namespace ldmx {
 
 std::ostream& operator<<(std::ostream&, const ldmx::TrigScintID&);
 
+namespace std {
+    template<> struct hash<ldmx::TrigScintID> : ldmx::DetectorIDHash { };
+}
+
 #endif // DETDESCR_TRIGSCINTID_H
@@ -9,15 +9,39 @@
 namespace ldmx {
 
 
-    std::map<DetectorIDInterpreter::IDSignature, const DetectorIDInterpreter::SubdetectorIDFields*> DetectorIDInterpreter::g_rosettaStone;
+    namespace {
+        /**
+         * The registry being built by this thread, only set while
+         * loadStandardInterpreters is running.
+         */
+        thread_local DetectorIDInterpreter::Registry* g_building{0};
+    }
+
+    const DetectorIDInterpreter::Registry& DetectorIDInterpreter::registry() {
+        // initialization of a function-local static happens exactly once even with
+        // concurrent callers, and the registry is const afterwards
+        static const Registry frozen = loadStandardInterpreters();
+        return frozen;
+    }
+
+    const DetectorIDInterpreter::SubdetectorIDFields* DetectorIDInterpreter::Registry::find(DetectorID id) const {
+        if (id.null()) return 0;
+
+        for (auto const& fields : layouts_[id.subdet()]) {
+            if ((id.raw()&fields.mask_)==fields.comparison_) return &fields;
+        }
+
+        // fell through, no match
+        return &layouts_[SD_NULL].front();
+    }
 
     DetectorIDInterpreter::~DetectorIDInterpreter()  {
     }
-    DetectorIDInterpreter::DetectorIDInterpreter() : id_(), p_fieldInfo_(0) {
+    DetectorIDInterpreter::DetectorIDInterpreter() : id_(), fieldValues_{}, p_fieldInfo_(0) {
         init();
     }
 
-    DetectorIDInterpreter::DetectorIDInterpreter(DetectorID did) : id_(did), p_fieldInfo_(0) {
+    DetectorIDInterpreter::DetectorIDInterpreter(DetectorID did) : id_(did), fieldValues_{}, p_fieldInfo_(0) {
         init();
         unpack();
     }
@@ -29,119 +53,113 @@ namespace ldmx {
     }
 
     void DetectorIDInterpreter::unpack() {	
-        std::fill(fieldValues_.begin(), fieldValues_.end(), 0);
+        fieldValues_.fill(0);
         if (!p_fieldInfo_) return;
-        for (auto field : p_fieldInfo_->fieldList_) {
-            unsigned result = (field->getBitMask() & id_.raw()) >> field->getStartBit();
-            this->fieldValues_[field->getIndex()] = result;
+        for (auto const& field : p_fieldInfo_->fieldList_) {
+            this->fieldValues_[field.getIndex()] = field.extract(id_.raw());
         }
     }
 
     void DetectorIDInterpreter::pack() {
         DetectorID::RawValue rawValue=0;
-        for (auto field : p_fieldInfo_->fieldList_) {
-            unsigned fieldValue = fieldValues_[field->getIndex()];
-            rawValue = rawValue | ((fieldValue << field->getStartBit()) & field->getBitMask());
+        for (auto const& field : p_fieldInfo_->fieldList_) {
+            unsigned fieldValue = fieldValues_[field.getIndex()];
+            rawValue = rawValue | ((fieldValue << field.getStartBit()) & field.getBitMask());
         }
         id_.setRawValue(rawValue);
     }
 
     DetectorIDInterpreter::FieldValue DetectorIDInterpreter::getFieldValue(int i) const {
-        IDField* field = p_fieldInfo_->fieldList_.at(i);
-        unsigned result = (field->getBitMask() & id_.raw()) >> field->getStartBit();
-        return result;
+        return p_fieldInfo_->fieldList_.at(i).extract(id_.raw());
     }
 
     void DetectorIDInterpreter::setFieldValue(int i, FieldValue val) {
-        fieldValues_[i] = val;
+        fieldValues_.at(i) = val;
         pack(); // keep packed
     }
 
     void DetectorIDInterpreter::setFieldValue(const std::string& fieldName, FieldValue fieldValue) {
-        auto byname=p_fieldInfo_->fieldMap_.find(fieldName);
-        if (byname!=p_fieldInfo_->fieldMap_.end()) fieldValues_[byname->second->getIndex()] = fieldValue;
+        const IDField* field = getField(fieldName);
+        if (field) fieldValues_[field->getIndex()] = fieldValue;
         pack(); // keep packed
     }
 
     const IDField* DetectorIDInterpreter::getField(const std::string& fieldName) const {
-        auto byname=p_fieldInfo_->fieldMap_.find(fieldName);
-        if (byname!=p_fieldInfo_->fieldMap_.end()) return (byname->second);
+        // only a handful of fields, faster to scan than to search a map
+        for (auto const& field : p_fieldInfo_->fieldList_) {
+            if (field.hasName(fieldName)) return &field;
+        }
         return 0;
     }
 
     DetectorIDInterpreter::FieldValue DetectorIDInterpreter::getFieldValue(const std::string& fieldName) const {
-        auto byname=p_fieldInfo_->fieldMap_.find(fieldName);
-        return getFieldValue(byname->second->getIndex());
+        const IDField* field = getField(fieldName);
+        if (!field) {
+            EXCEPTION_RAISE("DetectorIDException","No field named '"+fieldName+"' in this DetectorID.");
+        }
+        return field->extract(id_.raw());
     }
 
 
     void DetectorIDInterpreter::init() {
-        if (g_rosettaStone.empty()) loadStandardInterpreters();
-
-        p_fieldInfo_=0;
-
-        if (id_.null()) return;
-
-	for (auto ptr: g_rosettaStone) {
-	    if ((id_.raw()&ptr.first.mask_)==ptr.first.comparison_) {
-		p_fieldInfo_=(ptr.second);			
-		this->fieldValues_.resize(p_fieldInfo_->fieldList_.size());
-		return;
-	    }
-	}
-
-	// fell through, no match
-	IDSignature sig;
-	sig.comparison_=0;
-	sig.mask_=DetectorID::SUBDETECTORID_MASK<<DetectorID::SUBDETECTORID_SHIFT;
-	    
-	auto ptr = g_rosettaStone.find(sig);	    
-        p_fieldInfo_=(ptr->second);	
-        this->fieldValues_.resize(p_fieldInfo_->fieldList_.size());
-	    
+        p_fieldInfo_=registry().find(id_);
     }
 
     void DetectorIDInterpreter::registerInterpreter(SubdetectorIDType idtype,  const IDField::IDFieldList& fieldList) {
-	IDSignature sig;
-	sig.comparison_=idtype<<DetectorID::SUBDETECTORID_SHIFT;
-	sig.mask_=DetectorID::SUBDETECTORID_MASK<<DetectorID::SUBDETECTORID_SHIFT;
-	if (g_rosettaStone.find(sig)!=g_rosettaStone.end()) {
-            EXCEPTION_RAISE("DetectorIDException","Attempted to replace interpreter for subdetector "+std::to_string(idtype));
-	}
-        SubdetectorIDFields* fields=new SubdetectorIDFields();
-        fields->fieldList_=fieldList;
-        for (auto it : fieldList)
-            fields->fieldMap_[it->getFieldName()]=it;
-        g_rosettaStone[sig]=fields;
+        registerInterpreter(idtype,0,0,fieldList);
     }
 
     void DetectorIDInterpreter::registerInterpreter(SubdetectorIDType idtype,   unsigned int mask, unsigned int equality, const IDField::IDFieldList& fieldList) {
-	IDSignature sig;
-	sig.comparison_=(idtype<<DetectorID::SUBDETECTORID_SHIFT) | equality;
-	sig.mask_=(DetectorID::SUBDETECTORID_MASK<<DetectorID::SUBDETECTORID_SHIFT) | mask;
-        if (g_rosettaStone.find(sig)!=g_rosettaStone.end()) {
-            EXCEPTION_RAISE("DetectorIDException","Attempted to replace interpreter for subdetector "+std::to_string(idtype)+" mask "+std::to_string(mask)+" equality "+std::to_string(equality));
-	}
-        SubdetectorIDFields* fields=new SubdetectorIDFields();
-        fields->fieldList_=fieldList;
-        for (auto it : fieldList)
-            fields->fieldMap_[it->getFieldName()]=it;
-        g_rosettaStone[sig]=fields;
-    }
-
-    void DetectorIDInterpreter::loadStandardInterpreters() {
-        if (!g_rosettaStone.empty()) return;
-        IDField::IDFieldList fields;
-        fields.push_back(new IDField("subdetector",0,DetectorID::SUBDETECTORID_SHIFT,31));
-        fields.push_back(new IDField("payload",2,0,DetectorID::SUBDETECTORID_SHIFT-1));
-
-        registerInterpreter(SD_NULL,fields);
-
-        EcalID::createInterpreters();
-	EcalTriggerID::createInterpreters();
-        HcalID::createInterpreters();
-        TrackerID::createInterpreters();
-        TrigScintID::createInterpreters();
-        SimSpecialID::createInterpreters();
+        if (!g_building) {
+            EXCEPTION_RAISE("DetectorIDException","Attempted to register interpreter for subdetector "+std::to_string(idtype)+" after the registry was frozen");
+        }
+        g_building->add(idtype,mask,equality,fieldList);
+    }
+
+    void DetectorIDInterpreter::Registry::add(SubdetectorIDType idtype,   unsigned int mask, unsigned int equality, const IDField::IDFieldList& fieldList) {
+        if (idtype<0 || unsigned(idtype)>DetectorID::SUBDETECTORID_MASK) {
+            EXCEPTION_RAISE("DetectorIDException","Attempted to register interpreter for invalid subdetector "+std::to_string(idtype));
+        }
+        if (fieldList.size()>MAX_FIELDS) {
+            EXCEPTION_RAISE("DetectorIDException","Attempted to register interpreter with "+std::to_string(fieldList.size())+" fields for subdetector "+std::to_string(idtype));
+        }
+        for (auto const& field : fieldList) {
+            if (field.getIndex()>=fieldList.size()) {
+                EXCEPTION_RAISE("DetectorIDException","Field "+field.getFieldName()+" has an index past the end of the field list for subdetector "+std::to_string(idtype));
+            }
+        }
+        for (auto const& fields : layouts_[idtype]) {
+            if (fields.mask_==mask && fields.comparison_==(equality&mask)) {
+                EXCEPTION_RAISE("DetectorIDException","Attempted to replace interpreter for subdetector "+std::to_string(idtype)+" mask "+std::to_string(mask)+" equality "+std::to_string(equality));
+            }
+        }
+        layouts_[idtype].push_back(SubdetectorIDFields{mask,equality&mask,fieldList});
+    }
+
+    DetectorIDInterpreter::Registry DetectorIDInterpreter::loadStandardInterpreters() {
+        Registry registry;
+        g_building=&registry;
+
+        try {
+            static constexpr IDField fields[] = {
+                IDField("subdetector",0,DetectorID::SUBDETECTORID_SHIFT,31),
+                IDField("payload",1,0,DetectorID::SUBDETECTORID_SHIFT-1)
+            };
+
+            registerInterpreter(SD_NULL,fields);
+
+            EcalID::createInterpreters();
+            EcalTriggerID::createInterpreters();
+            HcalID::createInterpreters();
+            TrackerID::createInterpreters();
+            TrigScintID::createInterpreters();
+            SimSpecialID::createInterpreters();
+        } catch (...) {
+            g_building=0;
+            throw;
+        }
+
+        g_building=0;
+        return registry;
     }
 }
@@ -6,6 +6,8 @@
 #include "TMultiGraph.h"
 
 #include <assert.h>
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <iomanip>
 
@@ -33,12 +35,19 @@ namespace ldmx {
                 << ", and module " << moduler_ << " / " << moduleR_ << std::endl;
         }
 
+        auto start = std::chrono::steady_clock::now();
+
         buildModuleMap();
         buildCellMap();
+        buildCellLattice();
         buildCellModuleMap();
         buildNeighborMaps();
 
-        if(verbose_>0){ std::cout << std::endl; }
+        if(verbose_>0){
+            auto elapsed = std::chrono::duration<double,std::milli>(std::chrono::steady_clock::now()-start);
+            std::cout << std::endl << "[EcalHexReadout] Built geometry in " << std::setprecision(3) 
+                << elapsed.count() << " ms" << std::endl;
+        }
     }
 
     void EcalHexReadout::buildModuleMap(){
@@ -59,6 +68,8 @@ namespace ldmx {
             modulePositionMap_[id] = std::pair<double,double>(x,y);
             if(verbose_>2) std::cout << TString::Format("   id %d is at (%.2f, %.2f)",id,x,y) << std::endl;
         }
+        modulePositions_.clear();
+        for(auto const& module : modulePositionMap_) modulePositions_.push_back(module.second);
         if(verbose_>0) std::cout << std::endl;
     }
 
@@ -68,6 +79,7 @@ namespace ldmx {
          * then copy from it the polygons which cover a module.
          */
         TH2Poly gridMap;
+        clippedCells_.clear();
 
         // make hexagonal grid [boundary is rectangle] larger than the module
         double gridMinX = 0., gridMinY = 0.; //start at the origin
@@ -247,6 +259,7 @@ namespace ldmx {
                 }
                 //save cell location as center of ENTIRE hexagon
                 cellPositionMap_[ecalMapID] = std::pair<double,double>(x,y);
+                clippedCells_.push_back(numVerticesInside < 6);
                 ecalMapID++; //incrememnt cell ID
             } // if num vertices inside is > 1
         } //loop over larger grid spanning module hexagon
@@ -255,8 +268,84 @@ namespace ldmx {
         return;
     }
 
+    void EcalHexReadout::buildCellLattice(){
+        /** STRATEGY
+         * Convert each cell center to axial coordinates relative to cell 0.
+         * The centers are lattice sites so this rounding is exact.
+         * A cell is only added to the table if it and its six lattice neighbors
+         * are whole hexagons, otherwise a clipped polygon could cover part of it.
+         */
+        latticeOriginX_ = cellPositionMap_.at(0).first;
+        latticeOriginY_ = cellPositionMap_.at(0).second;
+
+        std::map<int,std::pair<int,int>> cellAxial;
+        int maxQ{0}, maxR{0};
+        latticeMinQ_ = 0;
+        latticeMinR_ = 0;
+        for(auto const& [cellID, xy] : cellPositionMap_) {
+            double dx = (xy.first - latticeOriginX_)/cellR_;
+            double dy = (xy.second - latticeOriginY_)/cellR_;
+            int q = int(std::round(dx/sqrt(3.) - dy/3.));
+            int r = int(std::round(2.*dy/3.));
+            cellAxial[cellID] = std::make_pair(q,r);
+            latticeMinQ_ = std::min(latticeMinQ_,q);
+            latticeMinR_ = std::min(latticeMinR_,r);
+            maxQ = std::max(maxQ,q);
+            maxR = std::max(maxR,r);
+        }
+
+        // leave a border of empty sites so neighbors are always in the table
+        latticeMinQ_ -= 1;
+        latticeMinR_ -= 1;
+        latticeNumQ_ = maxQ - latticeMinQ_ + 2;
+        latticeNumR_ = maxR - latticeMinR_ + 2;
+
+        // first mark which sites are clipped cells
+        std::vector<bool> clippedSite(latticeNumQ_*latticeNumR_, false);
+        for(auto const& [cellID, qr] : cellAxial) {
+            if (clippedCells_.at(cellID)) {
+                clippedSite[(qr.second-latticeMinR_)*latticeNumQ_+(qr.first-latticeMinQ_)] = true;
+            }
+        }
+
+        static const int neighbors[6][2] = { {1,0}, {-1,0}, {0,1}, {0,-1}, {1,-1}, {-1,1} };
+        latticeCells_.assign(latticeNumQ_*latticeNumR_, -1);
+        int numLatticeCells{0};
+        for(auto const& [cellID, qr] : cellAxial) {
+            int col = qr.first - latticeMinQ_;
+            int row = qr.second - latticeMinR_;
+            if (clippedSite[row*latticeNumQ_+col]) continue;
+            bool nextToClipped{false};
+            for (auto const& nb : neighbors) {
+                if (clippedSite[(row+nb[1])*latticeNumQ_+(col+nb[0])]) nextToClipped = true;
+            }
+            if (nextToClipped) continue;
+            latticeCells_[row*latticeNumQ_+col] = cellID;
+            numLatticeCells++;
+        }
+
+        if(verbose_>0) {
+            std::cout << std::endl << "[buildCellLattice] " << numLatticeCells << " of " << cellPositionMap_.size()
+                << " cells are found directly from the lattice." << std::endl;
+        }
+    }
+
     void EcalHexReadout::buildCellModuleMap(){
         if(verbose_>0) std::cout << std::endl << "[buildCellModuleMap] Building cellModule position map" << std::endl;
+
+        nModules_        = modulePositionMap_.size();
+        nCellsPerModule_ = cellPositionMap_.size();
+
+        cellPositions_.clear();
+        cellPositions_.reserve(nCellsPerModule_);
+        for(auto const& cell : cellPositionMap_) cellPositions_.push_back(cell.second);
+
+        cellModulePositions_.assign(nModules_*nCellsPerModule_, std::pair<double,double>(0.,0.));
+
+        layerZAbsolute_.clear();
+        layerZAbsolute_.reserve(layerZPositions_.size());
+        for(double z : layerZPositions_) layerZAbsolute_.push_back(ecalFrontZ_+z);
+
         for(auto const& module : modulePositionMap_) {
             int moduleID = module.first;
             double moduleX = module.second.first;
@@ -268,6 +357,7 @@ namespace ldmx {
                 double x = cellX+moduleX;
                 double y = cellY+moduleY;
                 cellModulePositionMap_[EcalID(0,moduleID,cellID)] = std::pair<double,double>(x,y);
+                cellModulePositions_[moduleID*nCellsPerModule_+cellID] = std::pair<double,double>(x,y);
             }
         }
         if(verbose_>0) std::cout << "  contained " << cellModulePositionMap_.size() << " entries. " << std::endl;
@@ -275,7 +365,7 @@ namespace ldmx {
 
     void EcalHexReadout::buildNeighborMaps(){
         /** STRATEGY
-         * Neighbors may include from other modules. All this is precomputed. So we can be wasteful here.
+         * Neighbors may include from other modules. All this is precomputed.
          * Gaps may be nonzero, so we simply apply an anulus requirement (r < point <= r+dr) using total x,y positions
          * relative to the ecal center (cell+module positions). This makes the routine portable to future cell layouts.
          * Note that the module centers already take into account a nonzero gap.
@@ -285,22 +375,63 @@ namespace ldmx {
          *   Chosen b/c in ideal case, centers are at 2*cell_ (NN), and at 3*cellR_=3.46*cellr_ and 4*cellr_ (NNN).
          */
 
-        NNMap_.clear();
-        NNNMap_.clear();
-        for(auto const& centerChannel : cellModulePositionMap_) {
-            EcalID centerID = centerChannel.first;
-            double centerX = centerChannel.second.first;
-            double centerY = centerChannel.second.second;
-            for(auto const& probeChannel : cellModulePositionMap_) {
-                EcalID probeID = probeChannel.first;
-                double probeX = probeChannel.second.first;
-                double probeY = probeChannel.second.second;
+        /** SEARCH
+         * Instead of comparing all pairs of cells, the cell centers are put into a square grid
+         * with a bin width of the largest neighbor distance. All of the neighbors of a cell are
+         * then in the 3x3 bins around the bin of the cell.
+         * The candidates are sorted so the neighbors are listed in ID order like the full search.
+         */
+        double binWidth = 4.5*cellr_;
+        double minX{1E12}, minY{1E12}, maxX{-1E12}, maxY{-1E12};
+        for(auto const& xy : cellModulePositions_) {
+            minX = std::min(minX,xy.first);
+            minY = std::min(minY,xy.second);
+            maxX = std::max(maxX,xy.first);
+            maxY = std::max(maxY,xy.second);
+        }
+        int numBinsX = int((maxX-minX)/binWidth)+1;
+        int numBinsY = int((maxY-minY)/binWidth)+1;
+        auto binX = [&](double x) { return int((x-minX)/binWidth); };
+        auto binY = [&](double y) { return int((y-minY)/binWidth); };
+        std::vector<std::vector<unsigned int>> bins(numBinsX*numBinsY);
+        for(unsigned int index = 0; index < cellModulePositions_.size(); index++) {
+            auto const& xy = cellModulePositions_[index];
+            bins[binY(xy.second)*numBinsX+binX(xy.first)].push_back(index);
+        }
+
+        NNOffsets_.assign(1,0);
+        NNList_.clear();
+        NNNOffsets_.assign(1,0);
+        NNNList_.clear();
+        std::vector<unsigned int> candidates;
+        for(unsigned int centerIndex = 0; centerIndex < cellModulePositions_.size(); centerIndex++) {
+            double centerX = cellModulePositions_[centerIndex].first;
+            double centerY = cellModulePositions_[centerIndex].second;
+            int centerBinX = binX(centerX), centerBinY = binY(centerY);
+
+            candidates.clear();
+            for(int iy = std::max(centerBinY-1,0); iy <= std::min(centerBinY+1,numBinsY-1); iy++) {
+                for(int ix = std::max(centerBinX-1,0); ix <= std::min(centerBinX+1,numBinsX-1); ix++) {
+                    auto const& bin = bins[iy*numBinsX+ix];
+                    candidates.insert(candidates.end(), bin.begin(), bin.end());
+                }
+            }
+            std::sort(candidates.begin(), candidates.end());
+
+            for(unsigned int probeIndex : candidates) {
+                EcalID probeID(0,probeIndex/nCellsPerModule_,probeIndex%nCellsPerModule_);
+                double probeX = cellModulePositions_[probeIndex].first;
+                double probeY = cellModulePositions_[probeIndex].second;
                 double dist = sqrt( (probeX-centerX)*(probeX-centerX) + (probeY-centerY)*(probeY-centerY) );
-                if(      dist > 1*cellr_  && dist <= 3.*cellr_)  { NNMap_[centerID].push_back(probeID); }
-                else if( dist > 3.*cellr_ && dist <= 4.5*cellr_) {NNNMap_[centerID].push_back(probeID); }
+                if(      dist > 1*cellr_  && dist <= 3.*cellr_)  { NNList_.push_back(probeID); }
+                else if( dist > 3.*cellr_ && dist <= 4.5*cellr_) {NNNList_.push_back(probeID); }
             }
-            if(verbose_>1) std::cout << TString::Format("Found %d NN and %d NNN for cellModuleID ",int(NNMap_[centerID].size()), int(NNNMap_[centerID].size()))
-				     << centerID << TString::Format(" with x,y (%.2f,%.2f)", centerX, centerY) << std::endl;
+            if(verbose_>1) std::cout << TString::Format("Found %d NN and %d NNN for cellModuleID ",
+                                int(NNList_.size()-NNOffsets_.back()), int(NNNList_.size()-NNNOffsets_.back()))
+				     << EcalID(0,centerIndex/nCellsPerModule_,centerIndex%nCellsPerModule_) 
+                     << TString::Format(" with x,y (%.2f,%.2f)", centerX, centerY) << std::endl;
+            NNOffsets_.push_back(NNList_.size());
+            NNNOffsets_.push_back(NNNList_.size());
         }
         if(verbose_>2){
             double specialX = 0.5*moduleR_ - 0.5*cellr_; // center of cell which is upper-right corner of center module
@@ -308,11 +439,11 @@ namespace ldmx {
 	    EcalID specialCellModuleID = getCellModuleID(specialX,specialY);
             std::cout << "The neighbors of the bin in the upper-right corner of the center module, with cellModuleID " 
                       << specialCellModuleID << " include " << std::endl;
-            for(auto centerNN : NNMap_.at(specialCellModuleID)){
+            for(auto centerNN : getNNRange(specialCellModuleID)){
 	      std::cout << " NN " << centerNN
 			<< TString::Format(" (x,y) (%.2f, %.2f)",getCellCenterAbsolute(centerNN).first,getCellCenterAbsolute(centerNN).second) << std::endl;
             }
-            for(auto centerNNN : NNNMap_.at(specialCellModuleID)){
+            for(auto centerNNN : getNNNRange(specialCellModuleID)){
 	      std::cout << " NNN " << centerNNN
 			<< TString::Format(" (x,y) (%.2f, %.2f)",getCellCenterAbsolute(centerNNN).first,getCellCenterAbsolute(centerNNN).second) << std::endl;
             }
@@ -10,11 +10,12 @@ std::ostream& operator<<(std::ostream& s, const ldmx::EcalID& id) {
 namespace ldmx {
 
   void EcalID::createInterpreters() {
-    IDField::IDFieldList fields;
-    fields.push_back(new IDField("subdetector",0,SUBDETECTORID_SHIFT,31));
-    fields.push_back(new IDField("layer",1,LAYER_SHIFT,LAYER_SHIFT+IDField::countOnes(LAYER_MASK)-1));
-    fields.push_back(new IDField("module",2,MODULE_SHIFT,MODULE_SHIFT+IDField::countOnes(MODULE_MASK)-1));
-    fields.push_back(new IDField("cell",3,CELL_SHIFT,CELL_SHIFT+IDField::countOnes(CELL_MASK)-1));
+    static constexpr IDField fields[] = {
+        IDField("subdetector",0,SUBDETECTORID_SHIFT,31),
+        IDField("layer",1,LAYER_SHIFT,LAYER_SHIFT+IDField::countOnes(LAYER_MASK)-1),
+        IDField("module",2,MODULE_SHIFT,MODULE_SHIFT+IDField::countOnes(MODULE_MASK)-1),
+        IDField("cell",3,CELL_SHIFT,CELL_SHIFT+IDField::countOnes(CELL_MASK)-1)
+    };
 
 
     DetectorIDInterpreter::registerInterpreter(SD_ECAL,
@@ -27,45 +28,86 @@ namespace ldmx {
 					       fields);
   }
 
-    static const unsigned int base_row_w=13;
-    static const unsigned int v_middle=11;
-    static const unsigned int max_v=23;
+    namespace {
+
+	const unsigned int base_row_w=13;
+	const unsigned int v_middle=11;
+	const unsigned int max_v=23;
+	const unsigned int max_u=23;
+	const unsigned int n_cells=432;
+
+	/**
+	 * Lookup tables between the cell number and (u,v) for a CMS-standard 432-cell sensor
+	 *
+	 * Row v has u from 0 to base_row_w-1+v below the middle row and
+	 * from v-v_middle to max_u above it, and the cells are numbered
+	 * along the rows starting from the bottom.
+	 */
+	struct UVTables {
+	    unsigned char cell_u[n_cells];
+	    unsigned char cell_v[n_cells];
+	    short uv_cell[max_u+1][max_v+1]; // -1 for (u,v) not on the sensor
+	};
+
+	constexpr UVTables buildUVTables() {
+	    UVTables t{};
+	    for (unsigned int u=0; u<=max_u; u++)
+		for (unsigned int v=0; v<=max_v; v++)
+		    t.uv_cell[u][v]=-1;
+	    unsigned int cell=0;
+	    for (unsigned int v=0; v<=max_v; v++) {
+		unsigned int umin=(v<=v_middle)?0:(v-v_middle);
+		unsigned int umax=(v<=v_middle)?(base_row_w-1+v):max_u;
+		for (unsigned int u=umin; u<=umax; u++) {
+		    t.cell_u[cell]=u;
+		    t.cell_v[cell]=v;
+		    t.uv_cell[u][v]=cell;
+		    cell++;
+		}
+	    }
+	    return t;
+	}
+
+	constexpr UVTables uv_tables=buildUVTables();
+
+	static_assert(uv_tables.uv_cell[max_u][max_v]==n_cells-1, "EcalID (u,v) table does not cover all of the cells");
+    }
     
     EcalID::EcalID(unsigned int layer, unsigned int module, unsigned int u, unsigned int v)  : EcalAbstractID(EcalAbstractID::PrecisionGlobal,0) {
 	id_|=(layer&LAYER_MASK)<<LAYER_SHIFT;
 	id_|=(module&MODULE_MASK)<<MODULE_SHIFT;
 
-	unsigned int cell=0;
-	if (v>max_v) {
+	if (u>max_u || v>max_v || uv_tables.uv_cell[u][v]<0) {
 	    EXCEPTION_RAISE("InvalidIdException","Attempted to create EcalID with invalid (u,v)=("+std::to_string(u)+","+std::to_string(v)+")");
 	}
-	
-	if (v<=v_middle) { // simple case...
-	    if (u>(base_row_w-1+v)) {
-		EXCEPTION_RAISE("InvalidIdException","Attempted to create EcalID with invalid (u,v)=("+std::to_string(u)+","+std::to_string(v)+")");
-	    }
-	    cell=u+v*base_row_w+(v-1)*v/2;
-	} else {
-	    unsigned int umin=v-v_middle;
-	    static unsigned int umax=23; // constant
-	    unsigned int vrel=v-v_middle-1;
-	    if (u<umin || u>umax) {
-		EXCEPTION_RAISE("InvalidIdException","Attempted to create EcalID with invalid (u,v)=("+std::to_string(u)+","+std::to_string(v)+")");
-	    }
-	    cell=222+(u-umin)+vrel*base_row_w+55-(v_middle-vrel-1)*(v_middle-vrel)/2;
-	}
+	unsigned int cell=uv_tables.uv_cell[u][v];
 	id_|=(cell&CELL_MASK)<<CELL_SHIFT;	
     }
 
-    static const int row_starts[25]={  0, 13, 27, 42, 58, 75, 93,112,132,153,175,198,
-				       222,245,267,288,308,327,345,362,378,393,407,420, -1};
-    
     std::pair<unsigned int,unsigned int> EcalID::getCellUV() const {
-	int cell=getCellID();
-	unsigned int v;
-	for (v=0; v<max_v && cell>=row_starts[v+1]; v++); // find the right v value
-	unsigned int u=cell-row_starts[v];
-	if (v>v_middle) u+=(v-v_middle);
-	return std::pair<unsigned int, unsigned int>(u,v);
+	unsigned int cell=getCellID();
+	if (cell<n_cells) return std::pair<unsigned int, unsigned int>(uv_tables.cell_u[cell],uv_tables.cell_v[cell]);
+	// cells past the sensor are counted along the top row
+	return std::pair<unsigned int, unsigned int>(cell-uv_tables.uv_cell[max_v-v_middle][max_v]+(max_v-v_middle),max_v);
+    }
+
+    void EcalID::unpack(const RawValue* ids, std::size_t n, int* layers, int* modules, int* cells) {
+	// the subdetector and cell type fields sit together above the payload,
+	// precision cell types (0 and 1) only differ in the lowest bit
+	const RawValue precision=((RawValue(SD_ECAL)<<3)|PrecisionGlobal)>>1;
+	RawValue mismatch=0;
+	for (std::size_t i=0; i<n; i++) {
+	    mismatch|=RawValue(ids[i]!=0)&RawValue((ids[i]>>(CELL_TYPE_SHIFT+1))!=precision);
+	}
+	if (mismatch) {
+	    // find the offending ID for the message, this is off the fast path
+	    for (std::size_t i=0; i<n; i++) EcalID check(ids[i]);
+	}
+
+	for (std::size_t i=0; i<n; i++) {
+	    layers[i]=(ids[i]>>LAYER_SHIFT)&LAYER_MASK;
+	    modules[i]=(ids[i]>>MODULE_SHIFT)&MODULE_MASK;
+	    cells[i]=(ids[i]>>CELL_SHIFT)&CELL_MASK;
+	}
     }
 }
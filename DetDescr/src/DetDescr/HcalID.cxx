@@ -9,14 +9,32 @@ std::ostream& operator<<(std::ostream& s, const ldmx::HcalID& id) {
 namespace ldmx {
 
   void HcalID::createInterpreters() {
-    IDField::IDFieldList fields;
-    fields.push_back(new IDField("subdetector",0,SUBDETECTORID_SHIFT,31));
-    fields.push_back(new IDField("section",1,SECTION_SHIFT,SECTION_SHIFT+IDField::countOnes(SECTION_MASK)-1));
-    fields.push_back(new IDField("layer",2,LAYER_SHIFT,LAYER_SHIFT+IDField::countOnes(LAYER_MASK)-1));
-    fields.push_back(new IDField("strip",3,STRIP_SHIFT,STRIP_SHIFT+IDField::countOnes(STRIP_MASK)-1));
+    static constexpr IDField fields[] = {
+        IDField("subdetector",0,SUBDETECTORID_SHIFT,31),
+        IDField("section",1,SECTION_SHIFT,SECTION_SHIFT+IDField::countOnes(SECTION_MASK)-1),
+        IDField("layer",2,LAYER_SHIFT,LAYER_SHIFT+IDField::countOnes(LAYER_MASK)-1),
+        IDField("strip",3,STRIP_SHIFT,STRIP_SHIFT+IDField::countOnes(STRIP_MASK)-1)
+    };
 
     DetectorIDInterpreter::registerInterpreter(SD_HCAL,fields);
 
   }
 
+  void HcalID::unpack(const RawValue* ids, std::size_t n, int* sections, int* layers, int* strips) {
+    RawValue mismatch=0;
+    for (std::size_t i=0; i<n; i++) {
+      mismatch|=RawValue(ids[i]!=0)&RawValue((ids[i]>>SUBDETECTORID_SHIFT)!=SD_HCAL);
+    }
+    if (mismatch) {
+      // find the offending ID for the message, this is off the fast path
+      for (std::size_t i=0; i<n; i++) HcalID check(ids[i]);
+    }
+
+    for (std::size_t i=0; i<n; i++) {
+      sections[i]=(ids[i]>>SECTION_SHIFT)&SECTION_MASK;
+      layers[i]=(ids[i]>>LAYER_SHIFT)&LAYER_MASK;
+      strips[i]=(ids[i]>>STRIP_SHIFT)&STRIP_MASK;
+    }
+  }
+
 }
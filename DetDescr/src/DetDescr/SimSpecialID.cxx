@@ -12,10 +12,11 @@ std::ostream& operator<<(std::ostream& s, const ldmx::SimSpecialID& id) {
 namespace ldmx {
 
     void SimSpecialID::createInterpreters() {
-        IDField::IDFieldList fields;
-        fields.push_back(new IDField("subdetector",0,SUBDETECTORID_SHIFT,31));
-        fields.push_back(new IDField("subtype",1,SUBTYPE_SHIFT,SUBTYPE_SHIFT+IDField::countOnes(SUBTYPE_MASK)-1));
-        fields.push_back(new IDField("payload",2,0,IDField::countOnes(SUBTYPE_DATA_MASK)-1));
+        static constexpr IDField fields[] = {
+            IDField("subdetector",0,SUBDETECTORID_SHIFT,31),
+            IDField("subtype",1,SUBTYPE_SHIFT,SUBTYPE_SHIFT+IDField::countOnes(SUBTYPE_MASK)-1),
+            IDField("payload",2,0,IDField::countOnes(SUBTYPE_DATA_MASK)-1)
+        };
 
         DetectorIDInterpreter::registerInterpreter(SD_SIM_SPECIAL,fields);
 
@@ -11,7 +11,10 @@
 #include "DetDescr/TrigScintID.h"
 #include "DetDescr/TrackerID.h"
 #include "DetDescr/SimSpecialID.h"
+#include "DetDescr/DenseIndex.h"
 #include <sstream>
+#include <unordered_set>
+#include <vector>
 
 /**
  * Test for DetectorID function
@@ -42,6 +45,25 @@ TEST_CASE( "DetectorID" , "[DetDescr][functionality]" ) {
 	REQUIRE(did_ecal<did_raw);
 	REQUIRE(did_ecal!=did_null);	
     }
+    SECTION( "DetectorIDInterpreter" ) {
+	// subdetectors without a layout use the generic one
+	DetectorIDInterpreter dii(did_raw);
+	CHECK( dii.getFieldCount()==2 );
+	CHECK( dii.getFieldValue("subdetector")==EID_TRACKER );
+	CHECK( dii.getFieldValue("payload")==0 );
+	CHECK( dii.getField("layer")==0 );
+	CHECK_THROWS( dii.getFieldValue("layer") );
+
+	// layouts are picked by the cell type for the Ecal
+	CHECK( DetectorIDInterpreter(EcalID(1,2,3)).getFieldCount()==4 );
+	CHECK( DetectorIDInterpreter(EcalID(1,2,3)).getFieldValue("cell")==3 );
+
+	// the registry is frozen once built
+	IDField::IDFieldList fields{IDField("subdetector",0,DetectorID::SUBDETECTORID_SHIFT,31)};
+	CHECK_THROWS( DetectorIDInterpreter::registerInterpreter(EID_HCAL,fields) );
+	CHECK( DetectorIDInterpreter::registry().find(did_null)==0 );
+	CHECK( DetectorIDInterpreter::registry().find(did_hcal)->fieldList_.size()==4 );
+    }
     SECTION ( "EcalID" ) {
 	EcalID eid_empty;
 	EcalID eid_raw(0x14002020);
@@ -82,7 +104,122 @@ TEST_CASE( "DetectorID" , "[DetDescr][functionality]" ) {
 	CHECK( eid.layer()==23 );
 	CHECK( eid.module()==13 );
 	CHECK( eid.cell()==223 );
-	
+
+    }
+    SECTION ( "EcalID UV" ) {
+	// every cell on the sensor round trips through (u,v)
+	for (int cell=0; cell<432; cell++) {
+	    EcalID eid(3,2,cell);
+	    std::pair<unsigned int,unsigned int> uv=eid.getCellUV();
+	    EcalID from_uv(3,2,uv);
+	    CHECK( from_uv.cell()==cell );
+	    CHECK( from_uv==eid );
+	}
+
+	// every valid (u,v) round trips through the cell and the others throw
+	int n_valid=0;
+	for (unsigned int u=0; u<30; u++) {
+	    for (unsigned int v=0; v<30; v++) {
+		bool valid=(v<=11)?(u<=12+v):(v<=23 && u>=v-11 && u<=23);
+		if (valid) {
+		    n_valid++;
+		    EcalID eid(0,0,u,v);
+		    CHECK( eid.getCellUV()==std::make_pair(u,v) );
+		} else {
+		    CHECK_THROWS( EcalID(0,0,u,v) );
+		}
+	    }
+	}
+	CHECK( n_valid==432 );
+
+	CHECK( EcalID(0,0,0,0).cell()==0 );
+	CHECK( EcalID(0,0,12,0).cell()==12 );
+	CHECK( EcalID(0,0,0,1).cell()==13 );
+	CHECK( EcalID(0,0,1,12).cell()==222 );
+	CHECK( EcalID(0,0,23,23).cell()==431 );
+    }
+    SECTION ( "Batch Unpack" ) {
+	std::vector<DetectorID::RawValue> ecal_ids;
+	for (unsigned int layer=0; layer<34; layer+=3)
+	    for (unsigned int module=0; module<7; module++)
+		for (unsigned int cell=0; cell<432; cell+=17)
+		    ecal_ids.push_back(EcalID(layer,module,cell).raw());
+	ecal_ids.push_back(EcalAbstractID(EcalAbstractID::PrecisionLocal,0x1234).raw());
+	ecal_ids.push_back(did_null.raw());
+
+	std::vector<int> layers(ecal_ids.size()), modules(ecal_ids.size()), cells(ecal_ids.size());
+	EcalID::unpack(ecal_ids.data(),ecal_ids.size(),layers.data(),modules.data(),cells.data());
+	int n_mismatched=0;
+	for (std::size_t i=0; i<ecal_ids.size(); i++) {
+	    EcalID eid(ecal_ids[i]);
+	    if (eid.layer()!=layers[i] || eid.module()!=modules[i] || eid.cell()!=cells[i]) n_mismatched++;
+	}
+	CHECK( n_mismatched==0 );
+
+	// one bad ID anywhere in the batch is caught
+	ecal_ids.push_back(EcalAbstractID(EcalAbstractID::EcalCellType(2),0).raw());
+	layers.resize(ecal_ids.size()); modules.resize(ecal_ids.size()); cells.resize(ecal_ids.size());
+	CHECK_THROWS( EcalID::unpack(ecal_ids.data(),ecal_ids.size(),layers.data(),modules.data(),cells.data()) );
+	ecal_ids.back()=did_hcal.raw();
+	CHECK_THROWS( EcalID::unpack(ecal_ids.data(),ecal_ids.size(),layers.data(),modules.data(),cells.data()) );
+
+	std::vector<DetectorID::RawValue> hcal_ids;
+	for (unsigned int section=0; section<5; section++)
+	    for (unsigned int layer=0; layer<100; layer+=7)
+		for (unsigned int strip=0; strip<62; strip+=5)
+		    hcal_ids.push_back(HcalID(section,layer,strip).raw());
+	hcal_ids.push_back(did_null.raw());
+
+	std::vector<int> sections(hcal_ids.size()), hlayers(hcal_ids.size()), strips(hcal_ids.size());
+	HcalID::unpack(hcal_ids.data(),hcal_ids.size(),sections.data(),hlayers.data(),strips.data());
+	n_mismatched=0;
+	for (std::size_t i=0; i<hcal_ids.size(); i++) {
+	    HcalID hid(hcal_ids[i]);
+	    if (hid.section()!=sections[i] || hid.layer()!=hlayers[i] || hid.strip()!=strips[i]) n_mismatched++;
+	}
+	CHECK( n_mismatched==0 );
+
+	hcal_ids.insert(hcal_ids.begin(),did_ecal.raw());
+	sections.resize(hcal_ids.size()); hlayers.resize(hcal_ids.size()); strips.resize(hcal_ids.size());
+	CHECK_THROWS( HcalID::unpack(hcal_ids.data(),hcal_ids.size(),sections.data(),hlayers.data(),strips.data()) );
+    }
+    SECTION ( "Dense Index" ) {
+	EcalDenseIndex ecal_index({34,7,432});
+	REQUIRE( ecal_index.size()==34*7*432 );
+	// the index and the ID are inverses of each other
+	int n_mismatched=0;
+	std::unordered_set<EcalID> seen;
+	for (std::size_t i=0; i<ecal_index.size(); i++) {
+	    EcalID eid=ecal_index.id(i);
+	    if (!ecal_index.contains(eid) || ecal_index.index(eid)!=i) n_mismatched++;
+	    seen.insert(eid);
+	}
+	CHECK( n_mismatched==0 );
+	CHECK( seen.size()==ecal_index.size() );
+	CHECK( ecal_index.index(EcalID(1,2,3))==(1*7+2)*432+3 );
+	CHECK_FALSE( ecal_index.contains(EcalID(34,0,0)) );
+	CHECK_FALSE( ecal_index.contains(EcalID(0,0,432)) );
+	CHECK_THROWS( ecal_index.index(EcalID(0,7,0)) );
+	CHECK_THROWS( ecal_index.index(EcalID(did_null)) );
+	// only global precision cells are indexed, id() couldn't give back a local one
+	EcalID local((EcalID(1,2,3).raw()&~(EcalID::CELL_TYPE_MASK<<EcalID::CELL_TYPE_SHIFT))
+		     |(EcalID::PrecisionLocal<<EcalID::CELL_TYPE_SHIFT));
+	CHECK_FALSE( ecal_index.contains(local) );
+	CHECK_THROWS( ecal_index.index(local) );
+	CHECK_THROWS( ecal_index.id(ecal_index.size()) );
+
+	HcalDenseIndex hcal_index({5,100,62});
+	CHECK( hcal_index.index(HcalID(HcalID::LEFT,99,61))==hcal_index.size()-1 );
+	CHECK( hcal_index.id(hcal_index.index(HcalID(HcalID::TOP,23,17)))==HcalID(HcalID::TOP,23,17) );
+
+	TrigScintDenseIndex ts_index({3,50});
+	CHECK( ts_index.id(ts_index.index(TrigScintID(2,49)))==TrigScintID(2,49) );
+
+	// IDs hash by their raw value
+	std::unordered_set<DetectorID> ids{did_ecal,did_hcal,did_null};
+	CHECK( ids.count(did_ecal)==1 );
+	CHECK( ids.count(did_ts)==0 );
+	CHECK( std::hash<HcalID>{}(HcalID(did_hcal))==std::hash<DetectorID>{}(did_hcal) );
     }
     SECTION ( "HcalID" ) {
 	HcalID hid_empty;
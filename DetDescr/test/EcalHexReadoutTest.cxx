@@ -0,0 +1,105 @@
+/**
+ * @file EcalHexReadoutTest.cxx
+ * @brief Test the position <-> cell translations of EcalHexReadout
+ */
+#include "Framework/catch.hpp" //for TEST_CASE, REQUIRE, and other Catch2 macros
+
+#include "DetDescr/EcalHexReadout.h" //headers defining what we will be testing
+#include "EcalHexReadoutV12.h" //for the v12 readout
+
+#include <random>
+
+/**
+ * Test that the lattice lookup agrees with the TH2Poly search
+ *
+ * Random points are thrown over the rectangle bounding a module and
+ * the cell ID from getCellIDRelative is compared to the bin found
+ * by the TH2Poly directly.
+ */
+TEST_CASE( "EcalHexReadout" , "[DetDescr][functionality]" ) {
+
+    using namespace ldmx;
+    auto hexReadout = test::makeV12EcalHexReadout();
+
+    REQUIRE( hexReadout->getNumCellsPerModule() == 432 );
+    REQUIRE( hexReadout->getNumModulesPerLayer() == 7 );
+
+    SECTION( "Cell Centers" ) {
+        // the center of every cell must map back to that cell
+        for (int cell = 0; cell < hexReadout->getNumCellsPerModule(); cell++) {
+            auto xy = hexReadout->getCellCenterRelative(cell);
+            CHECK( hexReadout->getCellIDRelative(xy.first,xy.second) == cell );
+        }
+    }
+
+    SECTION( "Random Points" ) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<double> randX(-hexReadout->getModuleMaxR(),hexReadout->getModuleMaxR());
+        std::uniform_real_distribution<double> randY(-hexReadout->getModuleMinR(),hexReadout->getModuleMinR());
+
+        TH2Poly* polyMap = hexReadout->getCellPolyMap();
+        int numPoints{2000000}, numMismatched{0}, numOutside{0};
+        for (int i = 0; i < numPoints; i++) {
+            double x = randX(rng), y = randY(rng);
+            int polyCell = polyMap->FindBin(x,y)-1;
+            if (polyCell < 0) {
+                // not in any cell, should throw
+                numOutside++;
+                try {
+                    hexReadout->getCellIDRelative(x,y);
+                    numMismatched++;
+                } catch (...) { }
+            } else if (hexReadout->getCellIDRelative(x,y) != polyCell) {
+                numMismatched++;
+            }
+        }
+
+        CHECK( numOutside < numPoints );
+        CHECK( numMismatched == 0 );
+    }
+
+    SECTION( "Neighbors" ) {
+        // a cell near the center of the center module has a full ring of neighbors
+        EcalID flatCenter = hexReadout->getCellModuleID(2.,2.);
+        EcalID center(7,flatCenter.module(),flatCenter.cell());
+        auto nn = hexReadout->getNN(center);
+        CHECK( nn.size() == 6 );
+        for (auto const& id : nn) {
+            CHECK( id.layer() == 7 );
+            CHECK( hexReadout->isNN(center,id) );
+            CHECK( hexReadout->isNN(id,center) );
+            CHECK_FALSE( hexReadout->isNNN(center,id) );
+            CHECK_FALSE( hexReadout->isNN(center,EcalID(8,id.module(),id.cell())) );
+        }
+        auto nnn = hexReadout->getNNN(center);
+        CHECK( nnn.size() == 12 );
+        for (auto const& id : nnn) {
+            CHECK( id.layer() == 7 );
+            CHECK( hexReadout->isNNN(center,id) );
+        }
+    }
+
+    SECTION( "Neighbor Search" ) {
+        // compare the binned neighbor search to checking every pair of cells
+        const auto& positions = hexReadout->getCellModulePositionMap();
+        double cellr = hexReadout->getCellMinR();
+        int numMismatched{0};
+        for (auto const& [center, cxy] : positions) {
+            std::vector<EcalID> nn, nnn;
+            for (auto const& [probe, pxy] : positions) {
+                double dist = sqrt( (pxy.first-cxy.first)*(pxy.first-cxy.first) + (pxy.second-cxy.second)*(pxy.second-cxy.second) );
+                if (dist > 1*cellr and dist <= 3.*cellr) nn.push_back(probe);
+                else if (dist > 3.*cellr and dist <= 4.5*cellr) nnn.push_back(probe);
+            }
+            if (nn != hexReadout->getNN(center) or nnn != hexReadout->getNNN(center)) numMismatched++;
+        }
+        CHECK( numMismatched == 0 );
+    }
+
+    SECTION( "Cell Module IDs" ) {
+        // cell centers in every module map back to the same cell and module
+        for (auto const& [id, xy] : hexReadout->getCellModulePositionMap()) {
+            CHECK( hexReadout->getCellModuleID(xy.first,xy.second) == id );
+        }
+    }
+}
@@ -0,0 +1,58 @@
+/**
+ * @file EcalHexReadoutV12.h
+ * @brief EcalHexReadout with the v12 geometry, for tests and benchmarks
+ *
+ * Test support only, not installed with the DetDescr headers: the DetDescr
+ * tests include it from this directory and the benchmarks add it to their
+ * include path.
+ */
+
+#ifndef DETDESCR_TEST_ECALHEXREADOUTV12_H_
+#define DETDESCR_TEST_ECALHEXREADOUTV12_H_
+
+// STL
+#include <any>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// LDMX
+#include "DetDescr/EcalHexReadout.h"
+#include "Framework/Configure/Parameters.h"
+
+namespace ldmx {
+namespace test {
+
+    /**
+     * Build an EcalHexReadout with the v12 geometry parameters.
+     *
+     * The parameters are the ones set by make_v12 in
+     * DetDescr/python/EcalHexReadout.py and must be kept in sync with it.
+     * For the tests and benchmarks that need a readout without running the
+     * conditions system: processors get theirs from the EcalGeometryProvider.
+     *
+     * @return the readout, owned by the caller
+     */
+    inline std::unique_ptr<EcalHexReadout> makeV12EcalHexReadout() {
+        std::map<std::string,std::any> params;
+        params["gap"] = 1.5;
+        params["moduleMinR"] = 85.0;
+        params["layerZPositions"] = std::vector<double>{
+             7.850, 13.300, 26.400, 33.500, 47.950, 56.550, 72.250, 81.350, 97.050, 106.150,
+            121.850, 130.950, 146.650, 155.750, 171.450, 180.550, 196.250, 205.350, 221.050, 230.150,
+            245.850, 254.950, 270.650, 279.750, 298.950, 311.550, 330.750, 343.350, 362.550, 375.150,
+            394.350, 406.950, 426.150, 438.750 };
+        params["ecalFrontZ"] = 240.5;
+        params["nCellRHeight"] = 35.3;
+        params["verbose"] = 0;
+
+        Parameters ps;
+        ps.setParameters(params);
+        return std::unique_ptr<EcalHexReadout>(EcalHexReadout::debugMake(ps));
+    }
+
+} // namespace test
+} // namespace ldmx
+
+#endif
@@ -10,6 +10,9 @@
 #include <string>
 #include <vector>
 
+// LDMX
+#include "SimCore/Event/SimCalorimeterHit.h"
+
 // LDMX Framework
 #include "Framework/EventFile.h"
 #include "Framework/EventProcessor.h"
@@ -60,6 +63,27 @@ public:
    */
   void onProcessStart() final override;
 
+  /**
+   * Add the hits of one overlay event to the calorimeter hits of the sim
+   * event as contribs, one hit per channel ID. Channels without a hit yet
+   * get a new hit with the ID and position of the overlay hit.
+   *
+   * This is the merging done in produce for the collections that need
+   * contribs added (Ecal), kept separate from the event bus so it can be
+   * run on its own, e.g. by the benchmarks.
+   *
+   * @param[in] overlayHits hits of the overlay event
+   * @param[in] timeOffset time shift of the overlay event [ns]
+   * @param[in] incidentID incident ID given to the overlay contribs
+   * @param[in] trackID track ID given to the overlay contribs
+   * @param[in] pdgCode PDG ID given to the overlay contribs
+   * @param[in,out] hitMap the merged hits, by channel ID
+   */
+  static void addOverlayContribs(
+      const std::vector<SimCalorimeterHit> &overlayHits, float timeOffset,
+      int incidentID, int trackID, int pdgCode,
+      std::map<int, SimCalorimeterHit> &hitMap);
+
 private:
   /**
    * Pileup overlay events input file name
@@ -12,6 +12,7 @@
 //   LDMX   //
 //----------//
 #include "Tools/AnalysisUtils.h"
+#include "Tools/SimHitIndex.h"
 #include "SimCore/Event/SimCalorimeterHit.h"
 #include "SimCore/Event/SimParticle.h"
 #include "Framework/EventProcessor.h"
@@ -62,15 +62,40 @@ namespace ldmx {
 
         private:
 
+            /**
+             * Build the mask of cells belonging to the central tower.
+             *
+             * The mask is indexed by module*(cells per module)+cell and a cell
+             * is marked if its center (relative to the ecal center) is within
+             * centerTowerRadius_ of the origin. This is done once per run, the
+             * granularity at which conditions like the geometry can change, so
+             * that the per-hit decision in produce is a single bit test.
+             *
+             * @param hexReadout geometry to build the mask from
+             */
+            void buildCenterTowerMask(const EcalHexReadout& hexReadout);
+
             /** The energy sum to make cut on. */
             float layerESumCut_{0};
 
             /** The trigger mode to run in. Mode zero sums over
-             * all cells in layer, while in mode 1 only cells in
-             * center module are summed over. (TODO)
+             * all cells in layer, while in mode 1 only cells within
+             * centerTowerRadius_ of the ecal center are summed over.
              */
             int mode_{0};
 
+            /** Radius of the central tower used in mode 1 [mm]. */
+            double centerTowerRadius_{0};
+
+            /** Mask of cells inside the central tower (index is module*nCells+cell). */
+            std::vector<bool> centerTowerMask_;
+
+            /** Number of cells per module used to index centerTowerMask_. */
+            int maskCellsPerModule_{0};
+
+            /** Run that centerTowerMask_ was built for, -1 before the first event. */
+            int maskRun_{-1};
+
             /** The first layer of layer sum. */
             int startLayer_{0};
 
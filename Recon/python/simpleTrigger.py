@@ -18,6 +18,7 @@ class TriggerProcessor(ldmxcfg.Producer) :
 
         self.threshold = 1500.0
         self.mode = 0
+        self.center_tower_radius = 100.0 #mm, only used in mode 1
         self.start_layer = 1
         self.end_layer = 20
         self.input_collection = "EcalRecHits"
@@ -194,36 +194,31 @@ void OverlayProducer::produce(Event &event) {
       ldmx_log(debug) << "in loop: size of overlay hits vector is "
                       << overlayHits.size();
 
-      for (SimCalorimeterHit &overlayHit : overlayHits) {
-        if (verbosity_ > 2)
-          overlayHit.Print();
+      if (needsContribsAdded) { // special treatment for (for now only) ecal
+        if (verbosity_ > 2) {
+          for (const SimCalorimeterHit &overlayHit : overlayHits)
+            overlayHit.Print();
+        }
+        // add the overlay hits (as) contribs
+        // incidentID = -1000, trackID = -1000, pdgCode = 0  <-- these are set
+        // in the header for now but could be parameters
+        addOverlayContribs(overlayHits, timeOffset, overlayIncidentID_,
+                           overlayTrackID_, overlayPdgCode_, hitMap);
+      } // if add overlay as contribs
+      else {
+        for (SimCalorimeterHit &overlayHit : overlayHits) {
+          if (verbosity_ > 2)
+            overlayHit.Print();
 
-        const float overlayTime = overlayHit.getTime() + timeOffset;
-        overlayHit.setTime(overlayTime);
+          const float overlayTime = overlayHit.getTime() + timeOffset;
+          overlayHit.setTime(overlayTime);
 
-        if (needsContribsAdded) { // special treatment for (for now only) ecal
-          int overlayHitID = overlayHit.getID();
-          if (hitMap.find(overlayHitID) ==
-              hitMap.end()) { // there wasn't already a simhit in this id
-            hitMap[overlayHitID] = SimCalorimeterHit();
-            hitMap[overlayHitID].setID(overlayHitID);
-            std::vector<float> hitPos = overlayHit.getPosition();
-            hitMap[overlayHitID].setPosition(hitPos[0], hitPos[1], hitPos[2]);
-          }
-          // add the overlay hit (as a) contrib
-          // incidentID = -1000, trackID = -1000, pdgCode = 0  <-- these are set
-          // in the header for now but could be parameters
-          hitMap[overlayHitID].addContrib(overlayIncidentID_, overlayTrackID_,
-                                          overlayPdgCode_, overlayHit.getEdep(),
-                                          overlayTime);
-        } // if add overlay as contribs
-        else {
           caloCollectionMap[outCollName].push_back(overlayHit);
           if (verbosity_ > 2)
             ldmx_log(debug) << "Adding non-Ecal overlay hit to outhit vector "
                             << outCollName;
-        }
-      } // over overlay calo simhit collection
+        } // over overlay calo simhit collection
+      }
 
       if (!needsContribsAdded)
         ldmx_log(debug) << "Nhits in overlay collection " << outCollName << ": "
@@ -360,6 +355,23 @@ void OverlayProducer::produce(Event &event) {
   return;
 }
 
+void OverlayProducer::addOverlayContribs(
+    const std::vector<SimCalorimeterHit> &overlayHits, float timeOffset,
+    int incidentID, int trackID, int pdgCode,
+    std::map<int, SimCalorimeterHit> &hitMap) {
+  for (const SimCalorimeterHit &overlayHit : overlayHits) {
+    auto [it, isNew] = hitMap.try_emplace(overlayHit.getID());
+    SimCalorimeterHit &hit = it->second;
+    if (isNew) { // there wasn't already a simhit in this id
+      hit.setID(overlayHit.getID());
+      std::vector<float> hitPos = overlayHit.getPosition();
+      hit.setPosition(hitPos[0], hitPos[1], hitPos[2]);
+    }
+    hit.addContrib(incidentID, trackID, pdgCode, overlayHit.getEdep(),
+                   overlayHit.getTime() + timeOffset);
+  }
+}
+
 void OverlayProducer::onProcessStart() {
   if (verbosity_ > 2) {
     ldmx_log(debug) << "onProcessStart() ";
@@ -19,36 +19,16 @@ namespace ldmx {
     void RecoilMissesEcalSkimmer::produce(Event &event) { 
         
         // Get the collection of simulated particles from the event
-        auto particleMap{event.getMap< int, SimParticle >("SimParticles")};
+        const auto &particleMap{event.getMap< int, SimParticle >("SimParticles")};
         
         // Search for the recoil electron 
         auto [recoilTrackID, recoilElectron] = Analysis::getRecoil(particleMap);
 
-        // Get the collection of simulated Ecal hits from the event. 
-        const std::vector<SimCalorimeterHit> ecalSimHits = event.getCollection<SimCalorimeterHit>("EcalSimHits");
-       
-        // Loop through the Ecal hits and check if the recoil electron is 
-        // associated with any of them.  If there are any recoil electron hits
-        // in the Ecal, drop the event.
-        bool hasRecoilElectronHits = false; 
-        for (const SimCalorimeterHit &simHit : ecalSimHits ) {
-            
-            /*std::cout << "[ RecoilMissesEcalSkimmer ]: "  
-                      << "Number of hit contributions: "  
-                      << simHit->getNumberOfContribs() << std::endl;*/
-
-            for (int iContrib = 0; iContrib < simHit.getNumberOfContribs(); ++iContrib) {
-
-                SimCalorimeterHit::Contrib contrib = simHit.getContrib(iContrib);
-
-                if (contrib.trackID == recoilTrackID) { 
-                    /*std::cout << "[ RecoilMissesEcalSkimmer ]: " 
-                              << "Ecal hit associated with recoil electron." << std::endl; */
-                    
-                    hasRecoilElectronHits = true;
-                } 
-            } 
-        }
+        // Check if the recoil electron left any hit in the Ecal; the scan of 
+        // the Ecal hits stops at the first recoil electron hit.
+        const auto &ecalSimHits{event.getCollection<SimCalorimeterHit>("EcalSimHits")};
+        SimHitIndex<SimCalorimeterHit> ecalSimHitIndex{ecalSimHits};
+        bool hasRecoilElectronHits{ecalSimHitIndex.hasHits(recoilTrackID)}; 
        
         // Tell the skimmer to keep or drop the event based on whether there
         // were recoil electron hits found in the Ecal. 
@@ -7,6 +7,7 @@ namespace ldmx {
 
         layerESumCut_ = parameters.getParameter< double >("threshold");
         mode_ = parameters.getParameter< int >("mode");
+        centerTowerRadius_ = parameters.getParameter< double >("center_tower_radius");
         startLayer_ = parameters.getParameter< int >("start_layer");
         endLayer_ = parameters.getParameter< int >("end_layer");
         inputColl_ = parameters.getParameter< std::string >("input_collection");
@@ -19,8 +20,31 @@ namespace ldmx {
         }
     }
 
+    void TriggerProcessor::buildCenterTowerMask(const EcalHexReadout& hexReadout) {
+
+        maskCellsPerModule_ = hexReadout.getNumCellsPerModule();
+        centerTowerMask_.assign(hexReadout.getNumModulesPerLayer()*maskCellsPerModule_, false);
+
+        double radius2 = centerTowerRadius_*centerTowerRadius_;
+        for (auto const& [cellModuleID, xy] : hexReadout.getCellModulePositionMap()) {
+            if (xy.first*xy.first + xy.second*xy.second < radius2) {
+                centerTowerMask_[cellModuleID.module()*maskCellsPerModule_ + cellModuleID.cell()] = true;
+            }
+        }
+    }
+
     void TriggerProcessor::produce(Event& event) {
 
+        if (mode_ == 1) {
+            // conditions are valid for whole runs, so the mask only has to be
+            // rebuilt from the geometry when the run changes
+            int run = event.getEventHeader().getRun();
+            if (run != maskRun_) {
+                buildCenterTowerMask(getCondition<EcalHexReadout>(EcalHexReadout::CONDITIONS_OBJECT_NAME));
+                maskRun_ = run;
+            }
+        }
+
         /** Grab the Ecal hit collection for the given event */
         const std::vector<EcalHit> ecalRecHits = event.getCollection<EcalHit>(inputColl_);
 
@@ -34,11 +58,10 @@ namespace ldmx {
                 if (mode_ == 0) { // Sum over all cells in a given layer
                     layerDigiE[id.layer()] += hit.getEnergy();
                 } else if (mode_ == 1) { // Sum over cells in central tower only
-                    //std::pair<float, float> xyPos = hit->getCellCentroidXYPair(hit->getID());
-                    //float cellRadius = sqrt(pow(xyPos.first, 2) + pow(xyPos.second, 2));
-                    //if (cellRadius < MAGICNUMBERHERE) {
-                    //    layerDigiE[hit->getLayer()] += hit->getEnergy();
-                    //}
+                    unsigned int index = id.module()*maskCellsPerModule_ + id.cell();
+                    if (index < centerTowerMask_.size() and centerTowerMask_[index]) {
+                        layerDigiE[id.layer()] += hit.getEnergy();
+                    }
                 }
             }
         }
@@ -29,6 +29,9 @@ namespace ldmx {
 
     namespace Analysis {
 
+        /// Track ID of the recoil electron, the first particle of the event
+        constexpr int RECOIL_TRACK_ID{1};
+
         /**
          * Find and return the sim particle associated with the recoil electron.
          *
@@ -11,7 +11,10 @@
 //   C++ StdLib   //
 //----------------//
 #include <iostream>
+#include <cstdint>
+#include <memory>
 #include <time.h>
+#include <utility>
 #include <vector>
 
 //--------------//
@@ -52,17 +55,100 @@ class NoiseGenerator {
    */
   std::vector<double> generateNoiseHits(int emptyChannels); 
 
+  /**
+   * Generate noise hits into a caller-provided buffer.
+   *
+   * Same as above, but noiseHits is cleared and filled so its
+   * memory can be reused from one event to the next.
+   *
+   * @param[in] emptyChannels The total number of channels without a hit 
+   *                          on them.
+   * @param[out] noiseHits The amplitudes of the noise hits.
+   * @return The number of noise hits.
+   */
+  int generateNoiseHits(int emptyChannels, std::vector<double>& noiseHits); 
+
+  /**
+   * Generate noise hits and choose the empty channels they are on.
+   *
+   * Each empty channel has a noise hit with the probability of the
+   * noise being above threshold. The gaps between successive noisy
+   * channels are drawn from the geometric distribution, so the cost
+   * scales with the number of noise hits rather than the number of
+   * channels, and no channels have to be picked by the caller.
+   *
+   * @param[in] emptyChannels The total number of channels without a hit 
+   *                          on them.
+   * @param[out] channels The indices in [0,emptyChannels) of the noisy 
+   *                      channels, in increasing order.
+   * @param[out] noiseHits The amplitudes of the noise hits, in the same order.
+   * @return The number of noise hits.
+   */
+  int generateNoiseHits(int emptyChannels, std::vector<int>& channels, 
+      std::vector<double>& noiseHits); 
+
+  /**
+   * Generate noise hits on the channels of a detector that aren't hit.
+   *
+   * The channels are numbered by a dense index over the detector (e.g.
+   * DenseIndex in DetDescr) and the occupied ones are marked in a bitmap.
+   * Noise hits are placed uniformly among the unoccupied channels in one
+   * pass over the bitmap, using the geometric gaps between noisy channels
+   * and counting the free channels a word at a time, so the cost doesn't
+   * depend on how many channels are occupied and no rejection sampling is
+   * needed.
+   *
+   * @param[in] occupied Bitmap of the occupied channels: channel i is
+   *                     occupied if bit i%64 of word i/64 is set.
+   * @param[in] nChannels The total number of channels in the dense index.
+   * @param[out] noiseHits The (channel index, amplitude) of the noise hits,
+   *                       in increasing channel index.
+   * @return The number of noise hits.
+   */
+  int generateNoiseHits(const std::vector<uint64_t>& occupied, std::size_t nChannels,
+      std::vector<std::pair<std::size_t,double>>& noiseHits); 
+
   /** Set the noise threshold. */
-  void setNoiseThreshold(double noiseThreshold) { noiseThreshold_ = noiseThreshold; }
+  void setNoiseThreshold(double noiseThreshold) { noiseThreshold_ = noiseThreshold; prepared_ = false; }
 
   /** Set the mean noise. */
-  void setNoise(double noise) { noise_ = noise; };
+  void setNoise(double noise) { noise_ = noise; prepared_ = false; };
 
   /** Set the pedestal. */
-  void setPedestal(double pedestal) { pedestal_ = pedestal; }; 
+  void setPedestal(double pedestal) { pedestal_ = pedestal; prepared_ = false; }; 
         
  private:
 
+  /** 
+   * Compute the probability of a noise hit and the table of the tail above 
+   * threshold, if the configuration changed since they were last computed.
+   */
+  void prepare();
+
+  /** Draw the amplitude of a noise hit from the tail above threshold. */
+  double drawAboveThreshold();
+
+  /** Number of bins in the table of the Gaussian tail. */
+  static constexpr int TAIL_TABLE_SIZE{4096};
+
+  /** true if the integral and tail table match the configuration. */
+  bool prepared_{false};
+
+  /** Probability for the noise to be above threshold. */
+  double integral_{0};
+
+  /** log(1 - integral_), for drawing the gaps between noise hits. */
+  double logNoHit_{0};
+
+  /** 
+   * Gaussian: noise values at uniformly spaced fractions of the tail, 
+   * Poisson: cumulative probabilities from the threshold up. 
+   */
+  std::vector<double> tailTable_;
+
+  /** Poisson: noise value of the first entry of the tail table. */
+  double tailStart_{0};
+
   /** Random number generator. */
   std::unique_ptr<TRandom3> random_{nullptr};
 
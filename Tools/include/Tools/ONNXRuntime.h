@@ -9,6 +9,8 @@
 
 #include "onnxruntime_cxx_api.h"
 
+#include "Framework/Configure/Parameters.h"
+
 namespace ldmx::Ort {
 
   typedef std::vector<std::vector<float>> FloatArrays;
@@ -25,6 +27,24 @@ namespace ldmx::Ort {
      * @param session_options Configuration options of the ONNXRuntime Session. Leave empty to use the default.
      */
     ONNXRuntime(const std::string& model_path, const ::Ort::SessionOptions* session_options = nullptr);
+
+    /**
+     * Class constructor using a shared session.
+     * All of the ONNXRuntime objects created with the same model path and thread
+     * counts, in any processor or thread, share one Session, so the model is only
+     * loaded once. Sessions are safe to run from several threads at once.
+     * @param model_path Path to the ONNX model file.
+     * @param intra_op_threads Number of threads used to parallelize the execution within nodes, 0 for the ONNXRuntime default.
+     * @param inter_op_threads Number of threads used to parallelize the execution of the graph, 0 for the ONNXRuntime default.
+     */
+    ONNXRuntime(const std::string& model_path, int intra_op_threads, int inter_op_threads);
+
+    /**
+     * Class constructor from configuration parameters, using a shared session.
+     * @param parameters Parameters with the `model_path`, `intra_op_threads` and `inter_op_threads`.
+     */
+    ONNXRuntime(const ldmx::Parameters& parameters);
+
     ONNXRuntime(const ONNXRuntime&) = delete;
     ONNXRuntime& operator=(const ONNXRuntime&) = delete;
     ~ONNXRuntime();
@@ -43,6 +63,20 @@ namespace ldmx::Ort {
                     const std::vector<std::string>& output_names = {},
                     int64_t batch_size = 1) const;
 
+    /**
+     * Get the names of all the input nodes.
+     * @return A list of names of all the input nodes, in the order the model declares them.
+     */
+    const std::vector<std::string>& getInputNames() const;
+
+    /**
+     * Get the shape of a input node.
+     * The 0th dim is the batch size, set to 1.
+     * @param input_name Name of the input node.
+     * @return The shape of the input node as a vector of integers.
+     */
+    const std::vector<int64_t>& getInputShape(const std::string& input_name) const;
+
     /**
      * Get the names of all the output nodes.
      * @return A list of names of all the output nodes.
@@ -57,9 +91,174 @@ namespace ldmx::Ort {
      */
     const std::vector<int64_t>& getOutputShape(const std::string& output_name) const;
 
+    /**
+     * @class Binding
+     * @brief Preallocated input and output buffers of a model.
+     *
+     * The buffers and the tensors wrapping them are created once, with the
+     * shapes of the model for a fixed batch size. Callers get the input
+     * buffers by index, fill them in place and call run, which passes the
+     * tensors straight to the session without any name lookup, size check
+     * or allocation. The outputs are written into buffers owned by the
+     * binding, or into caller-owned buffers given to bindOutput.
+     *
+     * The model must outlive the binding, and all input and output nodes
+     * must have a fixed size apart from the batch dimension. A binding can
+     * only be run from one thread at a time; threads sharing a model each
+     * use their own binding.
+     */
+    class Binding {
+    public:
+      /**
+       * Class constructor.
+       * @param model The model to run.
+       * @param batch_size Number of samples in the buffers.
+       * @param output_names Names of the output nodes to get outputs from. Empty list means all output nodes.
+       */
+      Binding(const ONNXRuntime& model, int64_t batch_size = 1, const std::vector<std::string>& output_names = {});
+      Binding(const Binding&) = delete;
+      Binding& operator=(const Binding&) = delete;
+
+      /**
+       * Get the buffer of an input node.
+       * @param input Index of the input node, in the order of `getInputNames()`.
+       * @return Pointer to the `inputSize(input)` values of the input node, laid out as (batch_size, ...).
+       */
+      float* input(size_t input) { return input_values_[input].data(); }
+
+      /// @return The number of values in the buffer of the input node.
+      size_t inputSize(size_t input) const { return input_values_[input].size(); }
+
+      /**
+       * Write the values of an output node into a caller-owned buffer.
+       * @param output Index of the output node, in the order of `output_names`.
+       * @param data Buffer of at least `outputSize(output)` values, must outlive the binding or the next call to bindOutput.
+       */
+      void bindOutput(size_t output, float* data);
+
+      /**
+       * Get the values of an output node from the last run.
+       * @param output Index of the output node, in the order of `output_names`.
+       * @return Pointer to the `outputSize(output)` values of the output node.
+       */
+      const float* output(size_t output) const { return output_data_[output]; }
+
+      /// @return The number of values of the output node.
+      size_t outputSize(size_t output) const { return output_sizes_[output]; }
+
+      /// @return The number of samples in the buffers.
+      int64_t batchSize() const { return batch_size_; }
+
+      /// @return The model this binding runs.
+      const ONNXRuntime& model() const { return model_; }
+
+      /**
+       * Run the model on the input buffers.
+       * @param n_samples Only run the first n samples of the buffers, the whole batch if 0 or less.
+       */
+      void run(int64_t n_samples = 0);
+
+    private:
+      /// Create tensors over the first `n_samples` samples of the buffers
+      void makeTensors(int64_t n_samples, std::vector<::Ort::Value>& inputs, std::vector<::Ort::Value>& outputs);
+
+      const ONNXRuntime& model_;
+      int64_t batch_size_;
+
+      FloatArrays input_values_;
+
+      std::vector<const char*> output_node_names_;
+      std::vector<std::vector<int64_t>> output_node_dims_;
+      std::vector<size_t> output_sizes_;
+      FloatArrays output_values_;
+      std::vector<float*> output_data_;
+
+      std::vector<::Ort::Value> input_tensors_;
+      std::vector<::Ort::Value> output_tensors_;
+    };
+
+    /**
+     * @class Batch
+     * @brief Accumulates samples and runs them through the model in one call.
+     *
+     * Calling run once per event (or per cluster) pays the full overhead of a
+     * session call for a single sample. A Batch instead copies the features
+     * of each sample into the input buffers of a Binding for `max_batch_size`
+     * samples, runs all of the accumulated samples in one session call, and
+     * gives views into the output buffers of the binding.
+     */
+    class Batch {
+    public:
+      /**
+       * Class constructor.
+       * @param model The model the samples are run through.
+       * @param max_batch_size Maximum number of samples run in one call.
+       * @param output_names Names of the output nodes to get outputs from. Empty list means all output nodes.
+       */
+      Batch(const ONNXRuntime& model, int64_t max_batch_size, const std::vector<std::string>& output_names = {});
+
+      /**
+       * Add a sample to the batch.
+       * @param sample The features of the sample for each input node, ordered as in `getInputNames()`.
+       * Each array must have the size of one sample of its input node.
+       */
+      void add(const FloatArrays& sample);
+
+      /**
+       * Run all of the samples added since the last clear.
+       * The outputs stay available until the next run.
+       */
+      void run() {
+        if (size_ > 0) binding_.run(size_);
+      }
+
+      /**
+       * Forget the samples so new ones can be added.
+       */
+      void clear() { size_ = 0; }
+
+      /// @return The number of samples added since the last clear.
+      int64_t size() const { return size_; }
+
+      /// @return The maximum number of samples in the batch.
+      int64_t capacity() const { return binding_.batchSize(); }
+
+      /// @return true if no more samples can be added.
+      bool full() const { return size_ == capacity(); }
+
+      /**
+       * Get the output of a sample from the last run.
+       * @param output Index of the output node, in the order of `output_names`.
+       * @param sample Index of the sample in the batch.
+       * @return Pointer to the `outputSize(output)` values of the sample, valid until the next run.
+       */
+      const float* output(size_t output, int64_t sample) const {
+        return binding_.output(output) + sample * outputSize(output);
+      }
+
+      /// @return The number of values of one sample of the output node.
+      size_t outputSize(size_t output) const { return binding_.outputSize(output) / capacity(); }
+
+    private:
+      Binding binding_;
+      int64_t size_{0};
+    };
+
   private:
+    /**
+     * Get the shared session of a model, loading it if no ONNXRuntime is using it.
+     * @param model_path Path to the ONNX model file.
+     * @param intra_op_threads Number of threads used within nodes, 0 for the default.
+     * @param inter_op_threads Number of threads used across nodes, 0 for the default.
+     */
+    static std::shared_ptr<::Ort::Session> getSession(const std::string& model_path, int intra_op_threads, int inter_op_threads);
+
+    /// Read the names and shapes of the input and output nodes from the session
+    void readNodes();
+
     static ::Ort::Env env_;
-    std::unique_ptr<::Ort::Session> session_;
+    static ::Ort::MemoryInfo memory_info_;
+    std::shared_ptr<::Ort::Session> session_;
 
     std::vector<std::string> input_node_strings_;
     std::vector<const char*> input_node_names_;
@@ -0,0 +1,157 @@
+/**
+ * @file ParticleGraph.h
+ * @brief Read-only index over the SimParticles of an event
+ */
+
+#ifndef TOOLS_PARTICLEGRAPH_H
+#define TOOLS_PARTICLEGRAPH_H
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+//----------//
+//   ldmx   //
+//----------//
+#include "SimCore/Event/SimParticle.h"
+#include "Tools/AnalysisUtils.h"
+
+namespace ldmx {
+
+    /**
+     * @class ParticleGraph
+     * @brief Read-only graph of the SimParticles of an event
+     *
+     * Walking the parent/daughter links through the std::map of SimParticles
+     * costs a tree search for every step. The graph puts the particles in a
+     * contiguous array (in increasing track ID), maps track IDs to positions
+     * in that array with a hash table, and stores the daughters of every
+     * particle in one compressed (CSR) array of positions. Queries return
+     * positions in the array instead of copies of the particles.
+     *
+     * The graph points into the particle map it is built from, so it is only
+     * valid for as long as that map: the Framework reads every event into
+     * the same map, so build the graph in the analyze or produce call that
+     * uses it and don't keep it across events.
+     */
+    class ParticleGraph {
+
+        public:
+
+            /// Position returned when a particle isn't in the graph
+            static constexpr std::size_t NOT_FOUND{std::numeric_limits<std::size_t>::max()};
+
+            /**
+             * @class IndexRange
+             * @brief Contiguous range of positions in the graph
+             */
+            class IndexRange {
+
+                public:
+
+                    IndexRange(const std::size_t* begin, const std::size_t* end) : begin_{begin}, end_{end} { }
+
+                    const std::size_t* begin() const { return begin_; }
+                    const std::size_t* end() const { return end_; }
+                    std::size_t size() const { return end_ - begin_; }
+                    bool empty() const { return begin_ == end_; }
+                    std::size_t operator[](std::size_t i) const { return begin_[i]; }
+
+                private:
+
+                    const std::size_t* begin_;
+                    const std::size_t* end_;
+            };
+
+            /**
+             * Build the graph.
+             *
+             * Daughters that weren't saved in the map are left out.
+             *
+             * @param[in] particleMap map of sim particles, must outlive the graph
+             */
+            ParticleGraph(const std::map<int,SimParticle>& particleMap);
+
+            /// @return the number of particles in the graph
+            std::size_t size() const { return particles_.size(); }
+
+            /// @return the particle at the input position
+            const SimParticle& particle(std::size_t i) const { return *particles_[i]; }
+
+            /// @return the track ID of the particle at the input position
+            int trackID(std::size_t i) const { return trackIDs_[i]; }
+
+            /**
+             * Get the position of a particle.
+             *
+             * @param[in] trackID track ID of the particle
+             * @return the position of the particle, NOT_FOUND if it wasn't saved
+             */
+            std::size_t index(int trackID) const {
+                auto it{indices_.find(trackID)};
+                return it == indices_.end() ? NOT_FOUND : it->second;
+            }
+
+            /// @return the positions of the saved daughters of the particle at the input position
+            IndexRange daughters(std::size_t i) const {
+                return {daughters_.data() + daughterOffsets_[i], daughters_.data() + daughterOffsets_[i+1]};
+            }
+
+            /**
+             * Get the recoil electron, which always has the track ID
+             * Analysis::RECOIL_TRACK_ID.
+             *
+             * @return the position of the recoil electron, NOT_FOUND if it wasn't saved
+             */
+            std::size_t recoil() const { return index(Analysis::RECOIL_TRACK_ID); }
+
+            /**
+             * Get the photon that underwent a photo-nuclear reaction.
+             *
+             * Same selection as Analysis::getPNGamma: the first daughter of
+             * the recoil whose first daughter comes from a photo-nuclear
+             * reaction and whose energy is above threshold.
+             *
+             * @param[in] recoil position of the recoil electron
+             * @param[in] energyThreshold minimum energy of the photon
+             * @return the position of the PN photon, NOT_FOUND if there is none
+             */
+            std::size_t pnGamma(std::size_t recoil, double energyThreshold) const;
+
+            /**
+             * Get the descendants of a particle created by a process.
+             *
+             * @param[in] i position of the particle
+             * @param[in] process process that created the descendants
+             * @param[out] descendants positions of the matching descendants,
+             *      closest generations first
+             */
+            void descendants(std::size_t i, SimParticle::ProcessType process,
+                    std::vector<std::size_t>& descendants) const;
+
+        private:
+
+            /// the particles, in increasing track ID
+            std::vector<const SimParticle*> particles_;
+
+            /// track ID of each particle
+            std::vector<int> trackIDs_;
+
+            /// position of each track ID
+            std::unordered_map<int,std::size_t> indices_;
+
+            /// start of the daughters of each particle in daughters_, plus the end
+            std::vector<std::size_t> daughterOffsets_;
+
+            /// positions of the daughters of all particles
+            std::vector<std::size_t> daughters_;
+    };
+
+} // ldmx
+
+#endif // TOOLS_PARTICLEGRAPH_H
@@ -0,0 +1,123 @@
+/**
+ * @file SimHitIndex.h
+ * @brief Truth-matching index from track IDs to sim hits
+ */
+
+#ifndef TOOLS_SIMHITINDEX_H
+#define TOOLS_SIMHITINDEX_H
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+//----------//
+//   ldmx   //
+//----------//
+#include "SimCore/Event/SimCalorimeterHit.h"
+#include "SimCore/Event/SimTrackerHit.h"
+
+namespace ldmx {
+
+    /**
+     * @class SimHitIndex
+     * @brief Index of the hits of a sim hit collection left by each track
+     *
+     * The index is filled lazily: a query only scans the collection as far
+     * as it needs to answer, and the hits it has scanned are remembered for
+     * the next queries. Asking whether a track left any hit can therefore
+     * stop at its first hit, while asking for all of the hits of a track
+     * finishes the scan once and then answers every later query with a
+     * hash lookup.
+     *
+     * The index refers to the collection it is built from, which the
+     * Framework refills for every event, so build it in the call that uses
+     * it and don't keep it across events.
+     *
+     * @tparam HitType SimCalorimeterHit, matched through its contributions,
+     *      or SimTrackerHit, matched through its track ID
+     */
+    template <class HitType>
+    class SimHitIndex {
+
+        public:
+
+            /**
+             * Constructor
+             *
+             * @param[in] hits collection to index, must outlive the index
+             */
+            SimHitIndex(const std::vector<HitType>& hits) : hits_{hits} { }
+
+            /// @return the indexed collection
+            const std::vector<HitType>& collection() const { return hits_; }
+
+            /**
+             * Check if a track left any hit in the collection.
+             *
+             * Only scans the collection up to the first hit of the track.
+             *
+             * @param[in] trackID track ID to look for
+             * @return true if at least one hit has a contribution from the track
+             */
+            bool hasHits(int trackID) {
+                if (hitsOf_.count(trackID)) return true;
+                while (next_ < hits_.size()) {
+                    scan(next_++);
+                    if (hitsOf_.count(trackID)) return true;
+                }
+                return false;
+            }
+
+            /**
+             * Get the hits left by a track.
+             *
+             * @param[in] trackID track ID to look for
+             * @return positions in the collection of the hits with a
+             *      contribution from the track, in increasing order
+             */
+            const std::vector<std::size_t>& hits(int trackID) {
+                while (next_ < hits_.size()) scan(next_++);
+                auto it{hitsOf_.find(trackID)};
+                return it == hitsOf_.end() ? none_ : it->second;
+            }
+
+        private:
+
+            /// Add a track to the hits it left
+            void add(int trackID, std::size_t iHit) {
+                auto& hits{hitsOf_[trackID]};
+                if (hits.empty() or hits.back() != iHit) hits.push_back(iHit);
+            }
+
+            /// Add the tracks of a calorimeter hit
+            void scan(const SimCalorimeterHit& hit, std::size_t iHit) {
+                for (int iContrib = 0; iContrib < hit.getNumberOfContribs(); ++iContrib) {
+                    add(hit.getContrib(iContrib).trackID, iHit);
+                }
+            }
+
+            /// Add the track of a tracker hit
+            void scan(const SimTrackerHit& hit, std::size_t iHit) { add(hit.getTrackID(), iHit); }
+
+            /// Add the tracks of the hit at the input position
+            void scan(std::size_t iHit) { scan(hits_[iHit], iHit); }
+
+            /// the indexed collection
+            const std::vector<HitType>& hits_;
+
+            /// position of the first hit that hasn't been scanned yet
+            std::size_t next_{0};
+
+            /// hits left by each track, for the scanned hits
+            std::unordered_map<int,std::vector<std::size_t>> hitsOf_;
+
+            /// returned for tracks without hits
+            const std::vector<std::size_t> none_;
+    };
+
+} // ldmx
+
+#endif // TOOLS_SIMHITINDEX_H
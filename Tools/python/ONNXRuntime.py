@@ -0,0 +1,23 @@
+"""Configuration for ONNX models run with ldmx::Ort::ONNXRuntime"""
+
+class ONNXRuntime() :
+    """Configuration for an ONNX model
+
+    Models with the same path and thread counts share one ONNXRuntime
+    session across all processors and threads of a job, so they are
+    only loaded once.
+
+    Attributes
+    ----------
+    model_path : str
+        Path to the ONNX model file
+    intra_op_threads : int
+        Threads used to parallelize the execution within nodes, 0 for the ONNXRuntime default
+    inter_op_threads : int
+        Threads used to parallelize the execution of the graph, 0 for the ONNXRuntime default
+    """
+
+    def __init__(self, model_path, intra_op_threads = 1, inter_op_threads = 0) :
+        self.model_path = model_path
+        self.intra_op_threads = intra_op_threads
+        self.inter_op_threads = inter_op_threads
@@ -9,6 +9,7 @@
 //-----------------//
 //   C++  StdLib   //
 //-----------------//
+#include <algorithm>
 #include <string>
 #include <tuple>
 
@@ -30,21 +31,21 @@ namespace ldmx {
 
         std::tuple<int, const SimParticle*> getRecoil(const std::map<int,SimParticle> &particleMap) {
             
-            // The recoil electron always has a track ID of 1.  
-            return {1, &(particleMap.at(1))};
+            // The recoil electron always has the same track ID.  
+            return {RECOIL_TRACK_ID, &(particleMap.at(RECOIL_TRACK_ID))};
         }
 
         const SimParticle* getPNGamma(const std::map< int, SimParticle >& particleMap, 
                 const SimParticle* recoil, const float& energyThreshold) {
            
             // Get all of the daughter track IDs
-            auto daughterTrackIDs{recoil->getDaughters()};
+            const auto &daughterTrackIDs{recoil->getDaughters()};
 
             auto pit = std::find_if(daughterTrackIDs.begin(), daughterTrackIDs.end(), 
-                    [energyThreshold, particleMap] (const int& id) {
+                    [energyThreshold, &particleMap] (const int& id) {
                     
                 // Get the SimParticle from the map
-                auto daughter{particleMap.at(id)};
+                const auto &daughter{particleMap.at(id)};
 
                 // If the particle doesn't have any daughters, return false
                 if (daughter.getDaughters().size() == 0) return false;
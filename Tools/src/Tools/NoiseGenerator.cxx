@@ -7,6 +7,11 @@
 #include "Tools/NoiseGenerator.h"
 #include "Framework/Exception/Exception.h"
 
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <string>
+
 namespace ldmx { 
 
 NoiseGenerator::NoiseGenerator(double noiseValue, bool gauss) {
@@ -22,53 +27,158 @@ void NoiseGenerator::seedGenerator(uint64_t seed) {
 }
     
 std::vector<double> NoiseGenerator::generateNoiseHits(int emptyChannels) { 
+  std::vector<double> noiseHits;
+  generateNoiseHits(emptyChannels, noiseHits);
+  return noiseHits;  
+}
+
+int NoiseGenerator::generateNoiseHits(int emptyChannels, std::vector<double>& noiseHits) { 
+
+  if (random_.get()==nullptr) {
+    EXCEPTION_RAISE("RandomSeedException","Noise generator was not seeded before use");
+  }
+  prepare();
+
+  noiseHits.clear();
+  int noiseHitCount = random_->Binomial(emptyChannels, integral_); 
+  for (int hitIndex = 0; hitIndex < noiseHitCount; ++hitIndex) { 
+    noiseHits.push_back(drawAboveThreshold()); 
+  }
+
+  return noiseHitCount;
+}
+
+int NoiseGenerator::generateNoiseHits(int emptyChannels, std::vector<int>& channels,
+    std::vector<double>& noiseHits) { 
+
+  if (random_.get()==nullptr) {
+    EXCEPTION_RAISE("RandomSeedException","Noise generator was not seeded before use");
+  }
+  prepare();
+
+  channels.clear();
+  noiseHits.clear();
+  if (integral_ <= 0.) return 0;
+
+  // Skip over the channels without noise: the number of them before the 
+  // next noise hit follows a geometric distribution.
+  double channel = -1;
+  while (true) {
+    if (integral_ < 1.) channel += 1. + std::floor(std::log(random_->Uniform())/logNoHit_);
+    else channel += 1.;
+    if (channel >= emptyChannels) break;
+    channels.push_back(int(channel));
+    noiseHits.push_back(drawAboveThreshold()); 
+  }
+
+  return channels.size();
+}
+
+int NoiseGenerator::generateNoiseHits(const std::vector<uint64_t>& occupied, std::size_t nChannels,
+    std::vector<std::pair<std::size_t,double>>& noiseHits) { 
 
   if (random_.get()==nullptr) {
     EXCEPTION_RAISE("RandomSeedException","Noise generator was not seeded before use");
   }
-  // std::cout << "[ Noise Generator ]: Empty channels: " 
-  //           << emptyChannels << std::endl;
-  // std::cout << "[ Noise Generator ]: Normalized integration limit: " 
-  //          << noiseThreshold_ << std::endl;
-        
-  double integral;
+
+  std::size_t nWords = (nChannels + 63)/64;
+  if (occupied.size() < nWords) {
+    EXCEPTION_RAISE("NoiseGenerator","Occupancy bitmap has " + std::to_string(occupied.size()) 
+        + " words, " + std::to_string(nWords) + " are needed for " + std::to_string(nChannels) + " channels.");
+  }
+  prepare();
+
+  noiseHits.clear();
+  if (integral_ <= 0. or nWords == 0) return 0;
+
+  // Free channels of a word of the bitmap, ignoring the bits past the last channel
+  auto freeChannels = [&](std::size_t word) {
+    uint64_t free = ~occupied[word];
+    if (word == nWords - 1 and nChannels % 64 != 0) free &= (uint64_t(1) << (nChannels % 64)) - 1;
+    return free;
+  };
+
+  std::size_t word{0};
+  uint64_t free{freeChannels(0)};
+  while (true) {
+
+    // Number of free channels without noise before the next noise hit
+    double gap = integral_ < 1. ? std::floor(std::log(random_->Uniform())/logNoHit_) : 0.;
+    if (gap >= nChannels) break;
+    std::size_t skip = gap;
+
+    // Skip whole words until the noise hit is in the current one
+    std::size_t nFree = std::bitset<64>(free).count();
+    while (skip >= nFree) {
+      skip -= nFree;
+      if (++word == nWords) return noiseHits.size();
+      free = freeChannels(word);
+      nFree = std::bitset<64>(free).count();
+    }
+
+    // Drop the free channels skipped in this word, the lowest remaining one is noisy
+    for (std::size_t i = 0; i < skip; ++i) free &= free - 1;
+    uint64_t lowest = free & (~free + 1);
+    std::size_t bit = std::bitset<64>(lowest - 1).count();
+    noiseHits.emplace_back(word*64 + bit, drawAboveThreshold());
+    free &= free - 1;
+  }
+
+  return noiseHits.size();
+}
+
+void NoiseGenerator::prepare() {
+
+  if (prepared_) return;
+
   if( useGaussianModel_ ) 
-    integral = ROOT::Math::normal_cdf_c(noiseThreshold_, noise_, pedestal_);
+    integral_ = ROOT::Math::normal_cdf_c(noiseThreshold_, noise_, pedestal_);
   else 
-    integral = boost::math::cdf(complement(*poisson_dist_,noiseThreshold_-1));
-  //std::cout << "[ Noise Generator ]: Integral: " 
-  //          << integral << std::endl;
+    integral_ = boost::math::cdf(complement(*poisson_dist_,noiseThreshold_-1));
+  logNoHit_ = integral_ < 1. ? std::log1p(-integral_) : 0.;
 
-  double noiseHitCount = random_->Binomial(emptyChannels, integral); 
-  //std::cout << "[ Noise Generator ]: # Noise hits: " 
-  //          << noiseHitCount << std::endl;
-
-  std::vector<double> noiseHits;
-  for (int hitIndex = 0; hitIndex < noiseHitCount; ++hitIndex) { 
-            
-    double rand = random_->Uniform();
-    //std::cout << "[ Noise Generator ]: Rand: " 
-    //          << rand << std::endl;
-    double draw = integral*rand; 
-    //std::cout << "[ Noise Generator ]: Draw: " 
-    //          << draw << std::endl;
-            
-    double cumulativeProb = 1.0 - integral + draw;
-    //std::cout << "[ Noise Generator ]: Cumulative probability: " 
-    //          << cumulativeProb << std::endl;
-            
-    double valueAboveThreshold;
-    if( useGaussianModel_ )
-      valueAboveThreshold = ROOT::Math::gaussian_quantile(cumulativeProb, noise_);
-    else 
-      valueAboveThreshold = boost::math::quantile(*poisson_dist_,cumulativeProb);
-    //std::cout << "[ Noise Generator ]: Noise value: " 
-    //          << gaussAboveThreshold << std::endl;
-            
-    noiseHits.push_back(valueAboveThreshold); 
+  tailTable_.clear();
+  if ( useGaussianModel_ ) {
+    // Noise values at the fractions i/N of the tail above threshold. 
+    // The quantile of the complement keeps the precision for small integrals.
+    tailTable_.resize(TAIL_TABLE_SIZE);
+    for (int i = 0; i < TAIL_TABLE_SIZE; ++i) {
+      tailTable_[i] = ROOT::Math::gaussian_quantile_c(integral_*(1. - double(i)/TAIL_TABLE_SIZE), noise_);
+    }
+  } else {
+    // Cumulative probabilities of the values from the threshold up, 
+    // until the rest of the tail is negligible
+    tailStart_ = std::floor(noiseThreshold_ - 1) + 1;
+    double cumulative{0};
+    for (double value = tailStart_; cumulative < integral_*(1. - 1e-12) && tailTable_.size() < 100000; value += 1.) {
+      cumulative += boost::math::pdf(*poisson_dist_, value);
+      tailTable_.push_back(cumulative);
+    }
   }
 
-  return noiseHits;  
+  prepared_ = true;
+}
+
+double NoiseGenerator::drawAboveThreshold() {
+
+  double rand = random_->Uniform();
+
+  if ( useGaussianModel_ ) {
+    // Interpolate in the table, the last bin goes to infinity so it is 
+    // computed exactly.
+    double bin = rand*TAIL_TABLE_SIZE;
+    int index = int(bin);
+    if (index >= TAIL_TABLE_SIZE - 1) 
+      return ROOT::Math::gaussian_quantile_c(integral_*(1. - rand), noise_);
+    return tailTable_[index] + (bin - index)*(tailTable_[index+1] - tailTable_[index]);
+  } else {
+    // The first value whose cumulative probability reaches the draw
+    double draw = integral_*rand; 
+    auto it = std::lower_bound(tailTable_.begin(), tailTable_.end(), draw);
+    if (it == tailTable_.end()) 
+      return boost::math::quantile(*poisson_dist_, 1.0 - integral_ + draw);
+    return tailStart_ + (it - tailTable_.begin());
+  }
 }
 
 } // ldmx
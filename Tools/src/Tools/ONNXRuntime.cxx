@@ -7,22 +7,56 @@
 #include <numeric>
 #include <functional>
 #include <exception>
+#include <mutex>
+#include <tuple>
 
 namespace ldmx::Ort {
 
   using namespace ::Ort;
 
   Env ONNXRuntime::env_(ORT_LOGGING_LEVEL_WARNING, "");
+  MemoryInfo ONNXRuntime::memory_info_ = MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
 
   ONNXRuntime::ONNXRuntime(const std::string& model_path, const SessionOptions* session_options) {
-    // create session
+    // create session; custom options get their own session
     if (session_options) {
-      session_.reset(new Session(env_, model_path.c_str(), *session_options));
+      session_ = std::make_shared<Session>(env_, model_path.c_str(), *session_options);
     } else {
+      session_ = getSession(model_path, 1, 0);
+    }
+    readNodes();
+  }
+
+  ONNXRuntime::ONNXRuntime(const std::string& model_path, int intra_op_threads, int inter_op_threads)
+      : session_(getSession(model_path, intra_op_threads, inter_op_threads)) {
+    readNodes();
+  }
+
+  ONNXRuntime::ONNXRuntime(const ldmx::Parameters& parameters)
+      : ONNXRuntime(parameters.getParameter<std::string>("model_path"),
+                    parameters.getParameter<int>("intra_op_threads"),
+                    parameters.getParameter<int>("inter_op_threads")) {}
+
+  std::shared_ptr<Session> ONNXRuntime::getSession(const std::string& model_path, int intra_op_threads, int inter_op_threads) {
+    // sessions are only kept alive by the ONNXRuntime objects using them
+    static std::mutex mutex;
+    static std::map<std::tuple<std::string, int, int>, std::weak_ptr<Session>> sessions;
+
+    // the lock is held while loading so that a model is never loaded twice
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& cached = sessions[std::make_tuple(model_path, intra_op_threads, inter_op_threads)];
+    auto session = cached.lock();
+    if (!session) {
       SessionOptions sess_opts;
-      sess_opts.SetIntraOpNumThreads(1);
-      session_.reset(new Session(env_, model_path.c_str(), sess_opts));
+      if (intra_op_threads > 0) sess_opts.SetIntraOpNumThreads(intra_op_threads);
+      if (inter_op_threads > 0) sess_opts.SetInterOpNumThreads(inter_op_threads);
+      session = std::make_shared<Session>(env_, model_path.c_str(), sess_opts);
+      cached = session;
     }
+    return session;
+  }
+
+  void ONNXRuntime::readNodes() {
     AllocatorWithDefaultOptions allocator;
 
     // get input names and shapes
@@ -82,7 +116,7 @@ namespace ldmx::Ort {
 
     // create input tensor objects from data values
     std::vector<Value> input_tensors;
-    auto memory_info = MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    input_tensors.reserve(input_node_strings_.size());
     for (const auto& name : input_node_strings_) {
       auto iter = std::find(input_names.begin(), input_names.end(), name);
       if (iter == input_names.end()) {
@@ -96,20 +130,17 @@ namespace ldmx::Ort {
         throw std::runtime_error("Input array " + name + " has a wrong size of " + std::to_string(value->size()) + ", expected " + std::to_string(expected_len));
       }
       auto input_tensor =
-          Value::CreateTensor<float>(memory_info, value->data(), value->size(), input_dims.data(), input_dims.size());
+          Value::CreateTensor<float>(memory_info_, value->data(), value->size(), input_dims.data(), input_dims.size());
       assert(input_tensor.IsTensor());
       input_tensors.emplace_back(std::move(input_tensor));
     }
 
     // set output node names; will get all outputs if `output_names` is not provided
-    std::vector<const char*> run_output_node_names;
-    if (output_names.empty()) {
-      run_output_node_names = output_node_names_;
-    } else {
-      for (const auto& name : output_names) {
-        run_output_node_names.push_back(name.c_str());
-      }
+    std::vector<const char*> requested_output_node_names;
+    for (const auto& name : output_names) {
+      requested_output_node_names.push_back(name.c_str());
     }
+    const auto& run_output_node_names = output_names.empty() ? output_node_names_ : requested_output_node_names;
 
     // run
     auto output_tensors = session_->Run(RunOptions{nullptr},
@@ -121,6 +152,7 @@ namespace ldmx::Ort {
 
     // convert output to floats
     FloatArrays outputs;
+    outputs.reserve(output_tensors.size());
     for (auto& output_tensor : output_tensors) {
       assert(output_tensor.IsTensor());
 
@@ -136,6 +168,23 @@ namespace ldmx::Ort {
     return outputs;
   }
 
+  const std::vector<std::string>& ONNXRuntime::getInputNames() const {
+    if (session_) {
+      return input_node_strings_;
+    } else {
+      throw std::runtime_error("ONNXRuntime session is not initialized!");
+    }
+  }
+
+  const std::vector<int64_t>& ONNXRuntime::getInputShape(const std::string& input_name) const {
+    auto iter = input_node_dims_.find(input_name);
+    if (iter == input_node_dims_.end()) {
+      throw std::runtime_error("Input name " + input_name + " is invalid!");
+    } else {
+      return iter->second;
+    }
+  }
+
   const std::vector<std::string>& ONNXRuntime::getOutputNames() const {
     if (session_) {
       return output_node_strings_;
@@ -153,4 +202,110 @@ namespace ldmx::Ort {
     }
   }
 
+  ONNXRuntime::Binding::Binding(const ONNXRuntime& model, int64_t batch_size, const std::vector<std::string>& output_names)
+      : model_(model), batch_size_(batch_size) {
+    if (batch_size_ <= 0) {
+      throw std::runtime_error("Batch size must be positive, not " + std::to_string(batch_size_));
+    }
+
+    // the size of one sample of each node, from the dims after the batch dim
+    auto sample_size = [](const std::string& name, const std::vector<int64_t>& dims) {
+      int64_t size = 1;
+      for (size_t i = 1; i < dims.size(); i++) {
+        if (dims[i] <= 0) {
+          throw std::runtime_error("Node " + name + " has a dynamic dimension " + std::to_string(i) + ", it can't be bound");
+        }
+        size *= dims[i];
+      }
+      return size_t(size);
+    };
+
+    for (const auto& name : model_.input_node_strings_) {
+      input_values_.emplace_back(batch_size_ * sample_size(name, model_.input_node_dims_.at(name)));
+    }
+
+    const auto& names = output_names.empty() ? model_.output_node_strings_ : output_names;
+    for (const auto& name : names) {
+      auto iter = std::find(model_.output_node_strings_.begin(), model_.output_node_strings_.end(), name);
+      if (iter == model_.output_node_strings_.end()) {
+        throw std::runtime_error("Output name " + name + " is invalid!");
+      }
+      output_node_names_.push_back(iter->c_str());
+      output_node_dims_.push_back(model_.output_node_dims_.at(name));
+      output_sizes_.push_back(batch_size_ * sample_size(name, output_node_dims_.back()));
+      output_values_.emplace_back(output_sizes_.back());
+      output_data_.push_back(output_values_.back().data());
+    }
+
+    makeTensors(batch_size_, input_tensors_, output_tensors_);
+  }
+
+  void ONNXRuntime::Binding::bindOutput(size_t output, float* data) {
+    output_data_.at(output) = data;
+    // the owned buffer isn't needed anymore
+    std::vector<float>().swap(output_values_[output]);
+    auto dims = output_node_dims_[output];
+    dims[0] = batch_size_;
+    output_tensors_[output] = Value::CreateTensor<float>(memory_info_, data, output_sizes_[output], dims.data(), dims.size());
+  }
+
+  void ONNXRuntime::Binding::run(int64_t n_samples) {
+    if (n_samples > batch_size_) {
+      throw std::runtime_error("Can't run " + std::to_string(n_samples) + " samples with a batch size of " + std::to_string(batch_size_));
+    }
+
+    // partial batches need tensors with a smaller batch dim
+    std::vector<Value> partial_inputs, partial_outputs;
+    bool partial = n_samples > 0 && n_samples < batch_size_;
+    if (partial) makeTensors(n_samples, partial_inputs, partial_outputs);
+    auto& inputs = partial ? partial_inputs : input_tensors_;
+    auto& outputs = partial ? partial_outputs : output_tensors_;
+
+    model_.session_->Run(RunOptions{nullptr},
+                         model_.input_node_names_.data(),
+                         inputs.data(),
+                         inputs.size(),
+                         output_node_names_.data(),
+                         outputs.data(),
+                         outputs.size());
+  }
+
+  void ONNXRuntime::Binding::makeTensors(int64_t n_samples, std::vector<Value>& inputs, std::vector<Value>& outputs) {
+    inputs.clear();
+    for (size_t i = 0; i < input_values_.size(); i++) {
+      auto dims = model_.input_node_dims_.at(model_.input_node_strings_[i]);
+      dims[0] = n_samples;
+      auto size = input_values_[i].size() / batch_size_ * n_samples;
+      inputs.emplace_back(Value::CreateTensor<float>(memory_info_, input_values_[i].data(), size, dims.data(), dims.size()));
+    }
+    outputs.clear();
+    for (size_t i = 0; i < output_data_.size(); i++) {
+      auto dims = output_node_dims_[i];
+      dims[0] = n_samples;
+      auto size = output_sizes_[i] / batch_size_ * n_samples;
+      outputs.emplace_back(Value::CreateTensor<float>(memory_info_, output_data_[i], size, dims.data(), dims.size()));
+    }
+  }
+
+  ONNXRuntime::Batch::Batch(const ONNXRuntime& model, int64_t max_batch_size, const std::vector<std::string>& output_names)
+      : binding_(model, max_batch_size, output_names) {}
+
+  void ONNXRuntime::Batch::add(const FloatArrays& sample) {
+    if (full()) {
+      throw std::runtime_error("Batch is full, run and clear it before adding more samples");
+    }
+    const auto& input_names = binding_.model().getInputNames();
+    if (sample.size() != input_names.size()) {
+      throw std::runtime_error("Sample has " + std::to_string(sample.size()) + " inputs, expected " + std::to_string(input_names.size()));
+    }
+    for (size_t i = 0; i < sample.size(); i++) {
+      size_t sample_size = binding_.inputSize(i) / capacity();
+      if (sample[i].size() != sample_size) {
+        throw std::runtime_error("Input array " + input_names[i] + " has a wrong size of " + std::to_string(sample[i].size()) + ", expected " + std::to_string(sample_size));
+      }
+      std::copy(sample[i].begin(), sample[i].end(), binding_.input(i) + size_ * sample_size);
+    }
+    ++size_;
+  }
+
 } /* namespace ldmx::Ort */
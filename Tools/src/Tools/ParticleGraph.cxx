@@ -0,0 +1,78 @@
+/**
+ * @file ParticleGraph.cxx
+ * @brief Read-only index over the SimParticles of an event
+ */
+
+#include "Tools/ParticleGraph.h"
+
+namespace ldmx {
+
+    ParticleGraph::ParticleGraph(const std::map<int,SimParticle>& particleMap) {
+
+        particles_.reserve(particleMap.size());
+        trackIDs_.reserve(particleMap.size());
+        indices_.reserve(particleMap.size());
+        for (const auto& [trackID, particle] : particleMap) {
+            indices_[trackID] = particles_.size();
+            particles_.push_back(&particle);
+            trackIDs_.push_back(trackID);
+        }
+
+        daughterOffsets_.reserve(particles_.size() + 1);
+        daughterOffsets_.push_back(0);
+        for (const SimParticle* particle : particles_) {
+            for (int daughterTrackID : particle->getDaughters()) {
+                auto daughter{index(daughterTrackID)};
+                if (daughter != NOT_FOUND) daughters_.push_back(daughter);
+            }
+            daughterOffsets_.push_back(daughters_.size());
+        }
+    }
+
+    std::size_t ParticleGraph::pnGamma(std::size_t recoil, double energyThreshold) const {
+
+        for (int daughterTrackID : particles_[recoil]->getDaughters()) {
+
+            auto daughter{index(daughterTrackID)};
+            if (daughter == NOT_FOUND) continue;
+
+            // If the particle doesn't have any daughters, it can't be the PN gamma
+            const auto& granddaughterTrackIDs{particles_[daughter]->getDaughters()};
+            if (granddaughterTrackIDs.empty()) continue;
+
+            // If the particle has daughters that were a result of a
+            // photo-nuclear reaction, and its energy is above threshold,
+            // then tag it as the PN gamma.
+            auto granddaughter{index(granddaughterTrackIDs.front())};
+            if (granddaughter == NOT_FOUND) continue;
+            if ((particles_[granddaughter]->getProcessType() == SimParticle::ProcessType::photonNuclear)
+                    && (particles_[daughter]->getEnergy() >= energyThreshold)) return daughter;
+        }
+
+        return NOT_FOUND;
+    }
+
+    void ParticleGraph::descendants(std::size_t i, SimParticle::ProcessType process,
+            std::vector<std::size_t>& descendants) const {
+
+        descendants.clear();
+
+        // Breadth first so closer generations come first
+        std::vector<std::size_t> generation{i}, next;
+        std::vector<bool> visited(particles_.size(), false);
+        visited[i] = true;
+        while (!generation.empty()) {
+            next.clear();
+            for (auto parent : generation) {
+                for (auto daughter : daughters(parent)) {
+                    if (visited[daughter]) continue;
+                    visited[daughter] = true;
+                    if (particles_[daughter]->getProcessType() == process) descendants.push_back(daughter);
+                    next.push_back(daughter);
+                }
+            }
+            generation.swap(next);
+        }
+    }
+
+} // ldmx
@@ -0,0 +1,193 @@
+/**
+ * @file NoiseGeneratorTest.cxx
+ * @brief Test the noise hits drawn by NoiseGenerator
+ */
+#include "Framework/catch.hpp" //for TEST_CASE, REQUIRE, and other Catch2 macros
+
+#include "Tools/NoiseGenerator.h" //headers defining what we will be testing
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace ldmx {
+namespace test {
+
+/**
+ * Noise hits as drawn before the tail was tabulated: the Binomial number
+ * of hits, then one inversion of the full quantile function per hit.
+ *
+ * Uses the random numbers in the same order as NoiseGenerator, so with the
+ * same seed the hits can be compared one by one.
+ */
+std::vector<double> referenceNoiseHits(uint64_t seed, int emptyChannels,
+        double noise, double threshold, bool gauss) {
+    TRandom3 random(seed);
+    boost::math::poisson_distribution<> poisson(noise);
+    double integral = gauss ? ROOT::Math::normal_cdf_c(threshold, noise, 0.)
+        : boost::math::cdf(complement(poisson, threshold - 1));
+    int noiseHitCount = random.Binomial(emptyChannels, integral);
+    std::vector<double> noiseHits;
+    for (int hitIndex = 0; hitIndex < noiseHitCount; ++hitIndex) {
+        double cumulativeProb = 1.0 - integral + integral*random.Uniform();
+        if (gauss) noiseHits.push_back(ROOT::Math::gaussian_quantile(cumulativeProb, noise));
+        else noiseHits.push_back(boost::math::quantile(poisson, cumulativeProb));
+    }
+    return noiseHits;
+}
+
+/**
+ * Check that a set of counts has the mean and variance of Binomial(n,p),
+ * within about four standard errors.
+ */
+void checkBinomial(const std::vector<int>& counts, int n, double p) {
+    double mean{0}, var{0};
+    for (int c : counts) mean += c;
+    mean /= counts.size();
+    for (int c : counts) var += (c - mean)*(c - mean);
+    var /= counts.size() - 1;
+
+    double expMean{n*p}, expVar{n*p*(1 - p)};
+    CHECK(mean == Approx(expMean).margin(4*std::sqrt(expVar/counts.size())));
+    CHECK(var == Approx(expVar).epsilon(4*std::sqrt(2./(counts.size() - 1))));
+}
+
+} // namespace test
+} // namespace ldmx
+
+/**
+ * Test the tabulated tails and the geometric skipping.
+ */
+TEST_CASE( "NoiseGenerator" , "[Tools][functionality]" ) {
+
+    using namespace ldmx;
+
+    SECTION( "Gaussian tail matches the quantile inversion" ) {
+        for (auto [emptyChannels, threshold] : std::vector<std::pair<int,double>>{{10000,1.5}, {10000000,4.0}, {1000000000,5.5}}) {
+            NoiseGenerator generator(1.0, true);
+            generator.setNoiseThreshold(threshold);
+            generator.seedGenerator(11);
+
+            std::vector<double> hits;
+            generator.generateNoiseHits(emptyChannels, hits);
+            auto reference{test::referenceNoiseHits(11, emptyChannels, 1.0, threshold, true)};
+
+            // The table is interpolated linearly between the noise values at
+            // steps of 1/TAIL_TABLE_SIZE of the tail, so a hit may only move
+            // within its step: compare the fractions of the tail above the hits
+            double integral{ROOT::Math::normal_cdf_c(threshold, 1.0, 0.)};
+            auto tailFraction = [&](double noise) { return ROOT::Math::normal_cdf_c(noise, 1.0, 0.)/integral; };
+
+            REQUIRE( hits.size() == reference.size() );
+            REQUIRE( hits.size() > 10 );
+            for (std::size_t i = 0; i < hits.size(); ++i) {
+                CHECK( hits.at(i) >= threshold - 1e-9 );
+                CHECK( tailFraction(hits.at(i)) == Approx(tailFraction(reference.at(i))).margin(1./4096) );
+            }
+        }
+    }
+
+    SECTION( "Poisson tail matches the quantile inversion" ) {
+        for (auto [mean, threshold] : std::vector<std::pair<double,double>>{{3.,8.}, {0.5,2.}, {20.,40.}}) {
+            NoiseGenerator generator(mean, false);
+            generator.setNoise(mean);
+            generator.setNoiseThreshold(threshold);
+            generator.seedGenerator(12);
+
+            std::vector<double> hits;
+            generator.generateNoiseHits(1000000, hits);
+            auto reference{test::referenceNoiseHits(12, 1000000, mean, threshold, false)};
+
+            REQUIRE( hits.size() == reference.size() );
+            REQUIRE( hits.size() > 10 );
+            for (std::size_t i = 0; i < hits.size(); ++i) {
+                CHECK( hits.at(i) >= threshold );
+                CHECK( hits.at(i) == reference.at(i) );
+            }
+        }
+    }
+
+    SECTION( "Geometric skipping draws Binomial counts" ) {
+        const int emptyChannels{10000};
+        for (bool gauss : {true, false}) {
+            NoiseGenerator generator(gauss ? 1.0 : 3.0, gauss);
+            generator.setNoise(gauss ? 1.0 : 3.0);
+            generator.setNoiseThreshold(gauss ? 2.0 : 7.0);
+            generator.seedGenerator(13);
+            double integral = gauss ? ROOT::Math::normal_cdf_c(2.0, 1.0, 0.)
+                : boost::math::cdf(complement(boost::math::poisson_distribution<>(3.0), 6.0));
+
+            std::vector<int> counts, channels;
+            std::vector<double> hits;
+            for (int event = 0; event < 4000; ++event) {
+                int n = generator.generateNoiseHits(emptyChannels, channels, hits);
+                REQUIRE( n == int(channels.size()) );
+                REQUIRE( channels.size() == hits.size() );
+                for (std::size_t i = 0; i < channels.size(); ++i) {
+                    CHECK( channels.at(i) >= 0 );
+                    CHECK( channels.at(i) < emptyChannels );
+                    if (i > 0) CHECK( channels.at(i) > channels.at(i-1) );
+                }
+                counts.push_back(n);
+            }
+            test::checkBinomial(counts, emptyChannels, integral);
+        }
+    }
+
+    SECTION( "Noise hits on the unoccupied channels of a dense index" ) {
+        // Not a multiple of 64, so the last word has to be masked
+        const std::size_t nChannels{1000};
+        const std::size_t nWords{(nChannels + 63)/64};
+
+        // Half of the channels occupied at random, plus two full words
+        // so whole words are skipped
+        std::vector<uint64_t> occupied(nWords, 0);
+        TRandom3 random(14);
+        for (std::size_t i = 0; i < nChannels; ++i) {
+            if (random.Uniform() < 0.5) occupied[i/64] |= uint64_t(1) << (i%64);
+        }
+        occupied[3] = ~uint64_t(0);
+        occupied[4] = ~uint64_t(0);
+        auto isOccupied = [&](std::size_t i) { return (occupied[i/64] >> (i%64)) & 1; };
+
+        std::size_t nFree{0};
+        for (std::size_t i = 0; i < nChannels; ++i) nFree += !isOccupied(i);
+
+        NoiseGenerator generator(1.0, true);
+        generator.setNoiseThreshold(2.0);
+        generator.seedGenerator(15);
+        double integral{ROOT::Math::normal_cdf_c(2.0, 1.0, 0.)};
+
+        const int nEvents{20000};
+        std::vector<int> counts, perChannel(nChannels, 0);
+        std::vector<std::pair<std::size_t,double>> hits;
+        for (int event = 0; event < nEvents; ++event) {
+            int n = generator.generateNoiseHits(occupied, nChannels, hits);
+            REQUIRE( n == int(hits.size()) );
+            for (std::size_t i = 0; i < hits.size(); ++i) {
+                auto channel{hits.at(i).first};
+                REQUIRE( channel < nChannels );
+                REQUIRE( !isOccupied(channel) );
+                if (i > 0) REQUIRE( channel > hits.at(i-1).first );
+                CHECK( hits.at(i).second >= 2.0 - 1e-9 );
+                ++perChannel[channel];
+            }
+            counts.push_back(n);
+        }
+        test::checkBinomial(counts, nFree, integral);
+
+        // Every free channel is hit at the same rate: the chi2 of the counts
+        // against a flat rate is within about four sigma of its mean
+        double expected{nEvents*integral}, chi2{0};
+        for (std::size_t i = 0; i < nChannels; ++i) {
+            if (isOccupied(i)) continue;
+            chi2 += (perChannel[i] - expected)*(perChannel[i] - expected)/(expected*(1 - integral));
+        }
+        double ndf = nFree;
+        CHECK( chi2/ndf == Approx(1.).margin(4*std::sqrt(2./ndf)) );
+
+        // The bitmap must cover all of the channels
+        std::vector<uint64_t> tooShort(nWords - 1, 0);
+        CHECK_THROWS( generator.generateNoiseHits(tooShort, nChannels, hits) );
+    }
+}